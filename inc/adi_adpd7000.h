@@ -32,6 +32,31 @@
  * @brief Address macros
  */
 #define ADPD7000_TIME_SLOT_SPAN     ((REG_TS_CTRL_B_ADDR) - (REG_TS_CTRL_A_ADDR))
+#define ADPD7000_BIOZ_SLOT_SPAN     ((REG_BIOZ_AFECON_B_ADDR) - (REG_BIOZ_AFECON_A_ADDR))
+
+/*!
+ * @brief FIFO frame macros
+ */
+#define ADPD7000_FIFO_SIZE          (512)                       /*!< FIFO size in bytes */
+#define ADPD7000_ECG_MAX_OVER_SAMPLE (63)                       /*!< Max ECG samples in a sequence */
+#define ADPD7000_PPG_MAX_SLOT       (12)                        /*!< Max PPG slots in a sequence */
+#define ADPD7000_BIOZ_MAX_SLOT      (18)                        /*!< Max BioZ slots in a sequence */
+#define ADPD7000_PPG_LATEST_SLOT    (2)                         /*!< PPG slots with data registers, A and B */
+#define ADPD7000_SEQ_NUM_SIZE       (1)                         /*!< Sequence number size in bytes */
+#define ADPD7000_STAT_LEV0_SIZE     (2)                         /*!< PPG level 0 status size in bytes */
+#define ADPD7000_STAT_LEV1_SIZE     (2)                         /*!< PPG level 1 status size in bytes */
+#define ADPD7000_STAT_LEVX_SIZE     (3)                         /*!< BioZ saturation status size in bytes */
+#define ADPD7000_PPG_MAX_CHANNEL    (4)                         /*!< Max channels of a PPG slot */
+#define ADPD7000_FIFO_MAX_COLUMN    (ADPD7000_ECG_MAX_OVER_SAMPLE + ADPD7000_PPG_MAX_SLOT * ADPD7000_PPG_MAX_CHANNEL * 3 + ADPD7000_BIOZ_MAX_SLOT * 2 + 4) /*!< Max values in a sequence */
+#define ADPD7000_FIFO_ECG_FILLER    (0xFFFFFFFF)                /*!< Column value of an ECG sample slot left by a filler sample */
+
+/*!
+ * @brief Capture file macros
+ */
+#define ADPD7000_CAPTURE_VERSION    (1)                         /*!< Capture format version */
+#define ADPD7000_CODEC_MAX_ROWS     (256)                       /*!< Max rows in a codec block */
+#define ADPD7000_ALIGN_MAX_CHANNEL  (16)                        /*!< Max channels in an aligner */
+#define ADPD7000_ALIGN_QUEUE        (32)                        /*!< Aligned outputs a channel may run ahead, power of 2 */
 
 
 /*!
@@ -193,8 +218,132 @@ typedef struct
     uint8_t ppg_chnl_num;                                       /*!< PPG channel number */
     adi_adpd7000_ppg_fifo_config_t ppg_fifo[12];               /*!< PPG FIFO configuration */
     uint8_t bioz_slot;                                          /*!< BioZ slot number */
+    uint8_t seq_num_en;                                         /*!< 0 - disabled, 1 - sequence number appended to sequence */
+    uint8_t stat_lev0_en;                                       /*!< 0 - disabled, 1 - PPG level 0 status appended to sequence */
+    uint8_t stat_lev1_en;                                       /*!< 0 - disabled, 1 - PPG level 1 status appended to sequence */
+    uint8_t stat_levx_en;                                       /*!< 0 - disabled, 1 - BioZ saturation status appended to sequence */
+    uint8_t status_size;                                        /*!< Size of status bytes at the end of sequence */
 } adi_adpd7000_fifo_config_t;
 
+/*!
+ * @brief  adpd7000 FIFO status bytes at the end of a sequence
+ */
+typedef struct
+{
+    uint8_t  seq_num;                                           /*!< Sequence number */
+    uint16_t lev0;                                              /*!< PPG level 0 status, one bit per slot */
+    uint16_t lev1;                                              /*!< PPG level 1 status, one bit per slot */
+    uint32_t levx;                                              /*!< BioZ saturation status, one bit per slot */
+} adi_adpd7000_fifo_status_bytes_t;
+
+/*!
+ * @brief  adpd7000 sequence number and FIFO realignment tracking state
+ */
+typedef struct
+{
+    uint8_t  valid;                                             /*!< 0 - no sequence number seen yet */
+    uint8_t  seq_num;                                           /*!< Last sequence number */
+    uint32_t lost;                                              /*!< Total lost sequences */
+    uint16_t cut_ahead;                                         /*!< Whole sequences in FIFO before the cut sequence */
+    uint16_t cut_size;                                          /*!< Bytes of a sequence cut by overflow still in FIFO, 0 - none */
+} adi_adpd7000_fifo_seq_track_t;
+
+/*!
+ * @brief  adpd7000 FIFO drain plan, bus transfers to do in order after a FIFO status read
+ */
+typedef struct
+{
+    uint16_t head_discard;                                      /*!< Bytes to discard first, partial sequence left by underflow */
+    uint16_t seq_count;                                         /*!< Whole sequences to read */
+    uint16_t tail_discard;                                      /*!< Bytes to discard after the read, sequence cut by overflow */
+    uint16_t clear;                                             /*!< FIFO status error flags to write 1 to clear */
+    uint32_t lost;                                              /*!< Sequences discarded */
+} adi_adpd7000_fifo_plan_t;
+
+/*!
+ * @brief  adpd7000 FIFO drain result
+ */
+typedef struct
+{
+    uint16_t seq_count;                                         /*!< Whole sequences read into buffer */
+    uint16_t discard_size;                                      /*!< Bytes discarded to realign to sequence boundary */
+    uint8_t  oflow;                                             /*!< 1 - FIFO overflow detected */
+    uint8_t  uflow;                                             /*!< 1 - FIFO underflow detected */
+    uint8_t  spec_miss;                                         /*!< 1 - speculative read ran past FIFO data and was discarded */
+    uint32_t lost;                                              /*!< Lost sequences, exact if sequence number enabled, otherwise lower bound */
+} adi_adpd7000_fifo_drain_t;
+
+/*!
+ * @brief  adpd7000 device to host timestamp correlation state
+ */
+typedef struct
+{
+    uint32_t clk_freq;                                          /*!< Timestamp counter clock, unit: Hz */
+    double   forget;                                            /*!< Forgetting factor of linear fit, 0 < forget <= 1, 1 - no forgetting */
+    uint8_t  valid;                                             /*!< 0 - no capture yet */
+    uint32_t stamp;                                             /*!< Last raw timestamp */
+    int64_t  ext_stamp;                                         /*!< Last timestamp extended to 64 bits */
+    int64_t  host_base;                                         /*!< Host time origin, unit: us */
+    double   weight;                                            /*!< Sum of weights */
+    double   mean_x;                                            /*!< Weighted mean of timestamp */
+    double   mean_y;                                            /*!< Weighted mean of host time */
+    double   cov_xx;                                            /*!< Weighted timestamp variance sum */
+    double   cov_xy;                                            /*!< Weighted covariance sum */
+    double   slope;                                             /*!< Host us per timestamp count */
+} adi_adpd7000_ts_sync_t;
+
+/*!
+ * @brief  adpd7000 timeslot pulse timing, input of sequence schedule
+ */
+typedef struct
+{
+    uint32_t offset;                                            /*!< Timeslot start from sequence start, 0 - right after previous timeslot, unit: us */
+    uint16_t led_offset;                                        /*!< First LED pulse from timeslot start, unit: us */
+    uint16_t led_width;                                         /*!< LED pulse width, unit: us */
+    uint16_t pulse_period;                                      /*!< Pulse period, 0 - led_offset + led_width, unit: us */
+    uint16_t pulse_num;                                         /*!< Pulses per sample, 0 - BioZ timeslot sampled at start */
+    uint8_t  decimate;                                          /*!< Subsample ratio, 0 or 1 - every sequence */
+} adi_adpd7000_schedule_slot_t;
+
+/*!
+ * @brief  adpd7000 sequence schedule, acquisition time of each frame sample from sequence start
+ */
+typedef struct
+{
+    double   seq_period;                                        /*!< Sequence period, unit: us */
+    double   ecg_step;                                          /*!< ECG sample spacing, unit: us */
+    double   ppg[ADPD7000_PPG_MAX_SLOT];                        /*!< PPG sample time in sequence, unit: us */
+    double   bioz[ADPD7000_BIOZ_MAX_SLOT];                      /*!< BioZ sample time in sequence, unit: us */
+    uint8_t  ppg_decimate[ADPD7000_PPG_MAX_SLOT];               /*!< PPG subsample ratio */
+    uint8_t  bioz_decimate[ADPD7000_BIOZ_MAX_SLOT];             /*!< BioZ subsample ratio */
+    uint32_t seq_index;                                         /*!< Index from go of next sequence to stamp, gives subsample phase */
+    uint8_t  ecg_num;                                           /*!< ECG samples per sequence */
+    uint8_t  ppg_slot_num;                                      /*!< PPG slot number */
+    uint8_t  bioz_num;                                          /*!< BioZ slot number */
+} adi_adpd7000_schedule_t;
+
+/*!
+ * @brief  adpd7000 host time of each sample of a frame
+ */
+typedef struct
+{
+    int64_t  ecg[ADPD7000_ECG_MAX_OVER_SAMPLE];                 /*!< ECG sample time, unit: us */
+    int64_t  ppg[ADPD7000_PPG_MAX_SLOT];                        /*!< PPG sample time, unit: us */
+    int64_t  bioz[ADPD7000_BIOZ_MAX_SLOT];                      /*!< BioZ sample time, unit: us */
+} adi_adpd7000_frame_time_t;
+
+/*!
+ * @brief  adpd7000 FIFO threshold tuning state
+ */
+typedef struct
+{
+    uint32_t sys_clk;                                           /*!< System clock, unit: Hz */
+    uint32_t latency_us;                                        /*!< Worst case host wake up latency, unit: us */
+    uint32_t sequence_size;                                     /*!< Sequence size the threshold was tuned for */
+    uint32_t slot_freq;                                         /*!< Timeslot frequency the threshold was tuned for */
+    uint16_t threshold;                                         /*!< Tuned FIFO threshold */
+} adi_adpd7000_fifo_tune_t;
+
 /*!
  * @brief  return value for adi adpd7000 api
  */
@@ -207,6 +356,9 @@ typedef enum {
     API_ADPD7000_ERROR_REG_ACCESS               = -5,           /*!< Register access error */
     API_ADPD7000_ERROR_LOG_WRITE                = -6,           /*!< Log write error */
     API_ADPD7000_ERROR_FUSE_NOT_DONE            = -7,           /*!< Fuse not done */
+    API_ADPD7000_ERROR_BUFFER_FULL              = -8,           /*!< Buffer full */
+    API_ADPD7000_ERROR_BUFFER_EMPTY             = -9,           /*!< Buffer empty */
+    API_ADPD7000_ERROR_TIMEOUT                  = -10,          /*!< Device did not reach the awaited state */
 } adi_adpd7000_error_e;
 
 /*!
@@ -483,6 +635,43 @@ typedef struct
     uint8_t  agc_done;
 } adi_adpd7000_ppg_agc_run_t;
 
+/*!
+ * @brief  AGC gain update mode enumeration
+ */
+typedef enum {
+    API_ADPD7000_AGC_UPDATE_RESTART = 0,                        /*!< Stop sequencer, write, clear FIFO and restart as soon as an average completes */
+    API_ADPD7000_AGC_UPDATE_BURST   = 1,                        /*!< Write one burst per slot at a sequence boundary while running, by adi_adpd7000_agc_apply */
+} adi_adpd7000_agc_update_e;
+
+/*!
+ * @brief  AGC engine slot state
+ */
+typedef struct
+{
+    adi_adpd7000_ppg_agc_run_t run;                             /*!< Gain state of the slot */
+    uint16_t sample_count;                                      /*!< Samples since the last gain update of the slot */
+    uint16_t settle;                                            /*!< Sequences still to come at the old gain */
+    uint8_t  chnl;                                              /*!< Channel averaged, index into slot data */
+    uint8_t  decimate;                                          /*!< Sequences per sample, subsample ratio */
+    uint8_t  phase;                                             /*!< Sequences since the last sample */
+} adi_adpd7000_agc_slot_t;
+
+/*!
+ * @brief  AGC engine, one per device, slots are averaged and updated independently
+ */
+typedef struct
+{
+    adi_adpd7000_ppg_agc_cfg_t cfg;                             /*!< AGC configuration */
+    adi_adpd7000_agc_update_e update_mode;                      /*!< Gain update mode */
+    uint8_t  slot_num;                                          /*!< PPG slot number */
+    uint32_t sequence_size;                                     /*!< Size of data in FIFO during a sequence */
+    uint32_t update_count;                                      /*!< Gain updates written to device */
+    uint16_t pending;                                           /*!< bit i - slot i gain decided, waiting for adi_adpd7000_agc_apply */
+    uint16_t marking;                                           /*!< bit i - slot i gain written, first sample at it not seen yet */
+    uint16_t new_gain;                                          /*!< bit i - slot i sample of the last processed sequence is the first at its new gain */
+    adi_adpd7000_agc_slot_t slot[ADPD7000_PPG_MAX_SLOT];        /*!< Slot state */
+} adi_adpd7000_agc_t;
+
 /*!
  * @brief  adpd7000 bioz fifo data
  */
@@ -492,6 +681,55 @@ typedef struct
     uint32_t imag;                                               /* Q */
 } adi_adpd7000_bioz_slot_data_t;
 
+/*!
+ * @brief  adpd7000 sequence frame, all modalities of one FIFO sequence
+ */
+typedef struct
+{
+    uint32_t ecg_data[ADPD7000_ECG_MAX_OVER_SAMPLE];             /*!< ECG data, 24 bits */
+    uint8_t  ecg_status[ADPD7000_ECG_MAX_OVER_SAMPLE];           /*!< ECG status byte, 0 if status byte disabled */
+    uint8_t  ecg_num;                                            /*!< ECG sample number, filler samples are skipped */
+    adi_adpd7000_ppg_slot_data_t ppg_signal[ADPD7000_PPG_MAX_SLOT]; /*!< PPG signal data */
+    adi_adpd7000_ppg_slot_data_t ppg_dark[ADPD7000_PPG_MAX_SLOT];   /*!< PPG dark data */
+    adi_adpd7000_ppg_slot_data_t ppg_lit[ADPD7000_PPG_MAX_SLOT];    /*!< PPG lit data */
+    uint8_t  ppg_slot_num;                                       /*!< PPG slot number */
+    adi_adpd7000_bioz_slot_data_t bioz[ADPD7000_BIOZ_MAX_SLOT]; /*!< BioZ data */
+    uint8_t  bioz_num;                                           /*!< BioZ slot number */
+    adi_adpd7000_fifo_status_bytes_t status;                     /*!< Status bytes, fields not enabled are 0 */
+} adi_adpd7000_frame_t;
+
+/*!
+ * @brief  PPG value in a slot channel
+ */
+typedef enum {
+    API_ADPD7000_PPG_FIELD_SIGNAL   = 0,                        /*!< Signal */
+    API_ADPD7000_PPG_FIELD_DARK     = 1,                        /*!< Dark */
+    API_ADPD7000_PPG_FIELD_LIT      = 2,                        /*!< Lit */
+} adi_adpd7000_ppg_field_e;
+
+/*!
+ * @brief  adpd7000 view over one value of every sequence of a raw FIFO buffer, value i is decoded on access
+ */
+typedef struct
+{
+    const uint8_t *data;                                        /*!< First byte of value 0 */
+    uint32_t sequence_size;                                     /*!< Stride between sequences */
+    uint32_t len;                                               /*!< Number of values */
+    uint8_t  per_seq;                                           /*!< Values per sequence, ECG oversampling, 1 for others */
+    uint8_t  step;                                              /*!< Stride between values of one sequence */
+    uint8_t  size;                                              /*!< Value size in bytes, 0 - value not in FIFO, reads 0 */
+} adi_adpd7000_column_view_t;
+
+/*!
+ * @brief  adpd7000 view over a raw multi-sequence FIFO buffer, whole sequences only
+ */
+typedef struct
+{
+    const uint8_t *data;                                        /*!< FIFO data, first byte of a sequence */
+    adi_adpd7000_fifo_config_t *fifo;                           /*!< FIFO configuration */
+    uint32_t seq_num;                                           /*!< Number of whole sequences */
+} adi_adpd7000_fifo_view_t;
+
 /*!
  * @brief  BioZ slot number enumuration
 */
@@ -694,6 +932,315 @@ typedef enum {
     
 } adi_adpd7000_sys_clock_src_e;
 
+/**
+ * @brief  Stream frame callback function.
+ *
+ * @param  user_data    Pointer to user data registered with callbacks
+ * @param  frame        Decoded frame of one sequence
+ */
+typedef void (*adi_adpd7000_stream_frame_cb)(void *user_data, const adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Stream ECG callback function.
+ *
+ * @param  user_data    Pointer to user data registered with callbacks
+ * @param  ecg_data     ECG data
+ * @param  ecg_status   ECG status, 0 if status byte disabled
+ * @param  ecg_num      ECG sample number
+ */
+typedef void (*adi_adpd7000_stream_ecg_cb)(void *user_data, const uint32_t *ecg_data, const uint8_t *ecg_status, uint8_t ecg_num);
+
+/**
+ * @brief  Stream PPG callback function.
+ *
+ * @param  user_data    Pointer to user data registered with callbacks
+ * @param  signal_data  PPG signal data
+ * @param  dark_data    PPG dark data
+ * @param  lit_data     PPG lit data
+ * @param  slot_num     PPG slot number
+ */
+typedef void (*adi_adpd7000_stream_ppg_cb)(void *user_data, const adi_adpd7000_ppg_slot_data_t *signal_data,
+    const adi_adpd7000_ppg_slot_data_t *dark_data, const adi_adpd7000_ppg_slot_data_t *lit_data, uint8_t slot_num);
+
+/**
+ * @brief  Stream BioZ callback function.
+ *
+ * @param  user_data    Pointer to user data registered with callbacks
+ * @param  bioz         BioZ data
+ * @param  bioz_num     BioZ slot number
+ */
+typedef void (*adi_adpd7000_stream_bioz_cb)(void *user_data, const adi_adpd7000_bioz_slot_data_t *bioz, uint8_t bioz_num);
+
+/**
+ * @brief  Stream pool frame callback function. Frame is valid during the callback,
+ *         call adi_adpd7000_frame_pool_retain to keep it and adi_adpd7000_frame_pool_release when done.
+ *
+ * @param  user_data    Pointer to user data registered with callbacks
+ * @param  frame        Decoded frame of one sequence, allocated from pool
+ */
+typedef void (*adi_adpd7000_stream_pool_cb)(void *user_data, adi_adpd7000_frame_t *frame);
+
+/*!
+ * @brief  adpd7000 frame pool block
+ */
+typedef struct
+{
+    adi_adpd7000_frame_t frame;                                 /*!< Decoded frame, must be first member */
+    uint32_t ref;                                               /*!< Reference count, 0 if free */
+    uint32_t next;                                              /*!< Next free block index */
+} adi_adpd7000_pool_block_t;
+
+/*!
+ * @brief  adpd7000 fixed block frame pool over caller storage.
+ *         Frames are allocated from one context only and released from any context.
+ */
+typedef struct
+{
+    adi_adpd7000_pool_block_t *block;                           /*!< Block storage */
+    uint32_t block_num;                                         /*!< Block number */
+    uint32_t free_head;                                         /*!< First free block, block_num if pool empty */
+    uint32_t free_count;                                        /*!< Free block number */
+    uint32_t low_water;                                         /*!< Min free block number seen by allocator */
+    uint32_t fail_count;                                        /*!< Allocations failed because pool empty */
+} adi_adpd7000_frame_pool_t;
+
+/*!
+ * @brief  adpd7000 stream statistics
+ */
+typedef struct
+{
+    uint32_t irq_count;                                         /*!< Interrupt handler calls */
+    uint32_t empty_count;                                       /*!< Interrupt handler calls without a whole sequence */
+    uint32_t seq_count;                                         /*!< Sequences delivered */
+    uint32_t byte_count;                                        /*!< Bytes read from FIFO */
+    uint32_t oflow_count;                                       /*!< FIFO overflows */
+    uint32_t uflow_count;                                       /*!< FIFO underflows */
+    uint32_t lost_count;                                        /*!< Lost sequences */
+    uint32_t discard_count;                                     /*!< Bytes discarded for realignment */
+    uint32_t error_count;                                       /*!< Interrupt handler calls failed */
+    uint32_t pool_drop_count;                                   /*!< Frames not passed to pool callback because pool empty */
+    uint32_t spec_miss_count;                                   /*!< Speculative FIFO reads discarded */
+} adi_adpd7000_stream_stats_t;
+
+/*!
+ * @brief  adpd7000 interrupt driven stream
+ */
+typedef struct
+{
+    adi_adpd7000_device_t *device;                              /*!< Pointer to device structure */
+    adi_adpd7000_interrupt_type_e int_type;                     /*!< Interrupt pin used */
+    adi_adpd7000_fifo_config_t fifo;                            /*!< Sequence fifo configuration */
+    adi_adpd7000_fifo_seq_track_t track;                        /*!< Sequence number tracking */
+    uint16_t predict;                                           /*!< Bytes in FIFO when threshold interrupt fires */
+    void *user_data;                                            /*!< User data passed to callbacks */
+    adi_adpd7000_stream_frame_cb frame_cb;                      /*!< Frame callback, NULL if not used */
+    adi_adpd7000_stream_ecg_cb ecg_cb;                          /*!< ECG callback, NULL if not used */
+    adi_adpd7000_stream_ppg_cb ppg_cb;                          /*!< PPG callback, NULL if not used */
+    adi_adpd7000_stream_bioz_cb bioz_cb;                        /*!< BioZ callback, NULL if not used */
+    adi_adpd7000_frame_pool_t *pool;                            /*!< Frame pool, NULL if not used */
+    adi_adpd7000_stream_pool_cb pool_cb;                        /*!< Pool frame callback, NULL if not used */
+    adi_adpd7000_frame_t frame;                                 /*!< Decoded frame */
+    adi_adpd7000_stream_stats_t stats;                          /*!< Statistics */
+    uint8_t buf[ADPD7000_FIFO_SIZE];                            /*!< Drain buffer */
+} adi_adpd7000_stream_t;
+
+/*!
+ * @brief  adpd7000 single producer single consumer lock-free ring.
+ *         Producer and consumer indexes are kept on separate cache lines.
+ */
+typedef struct
+{
+    uint8_t  *buf;                                              /*!< Element storage, capacity * elem_size bytes */
+    uint32_t elem_size;                                         /*!< Element size in bytes */
+    uint32_t mask;                                              /*!< Capacity - 1, capacity is power of 2 */
+    uint8_t  pad0[ADPD7000_CACHE_LINE_SIZE];
+    uint32_t head;                                              /*!< Write index, written by producer only */
+    uint32_t high_water;                                        /*!< Max element count seen by producer */
+    uint32_t drop_count;                                        /*!< Elements dropped because ring full */
+    uint8_t  pad1[ADPD7000_CACHE_LINE_SIZE];
+    uint32_t tail;                                              /*!< Read index, written by consumer only */
+    uint8_t  pad2[ADPD7000_CACHE_LINE_SIZE];
+} adi_adpd7000_ring_t;
+
+/**
+ * @brief  Broadcast notify function, called after each publish, e.g. futex wake on head or eventfd write.
+ *
+ * @param  user_data    Pointer to user data registered with publisher
+ */
+typedef void (*adi_adpd7000_bcast_notify)(void *user_data);
+
+/*!
+ * @brief  adpd7000 broadcast ring header, first bytes of the shared region.
+ *         Region holds no pointers so processes may map it at different addresses,
+ *         reader slots and element storage follow the header.
+ */
+typedef struct
+{
+    uint32_t magic;                                             /*!< Set last when region is ready */
+    uint32_t elem_size;                                         /*!< Element size in bytes */
+    uint32_t mask;                                              /*!< Capacity - 1, capacity is power of 2 */
+    uint32_t reader_max;                                        /*!< Reader slot number */
+    uint8_t  pad0[ADPD7000_CACHE_LINE_SIZE - 16];
+    uint32_t head;                                              /*!< Write index, written by publisher only, 32 bits aligned for futex wait */
+    uint32_t drop_count;                                        /*!< Elements dropped because slowest reader is a ring behind */
+    uint8_t  pad1[ADPD7000_CACHE_LINE_SIZE - 8];
+} adi_adpd7000_bcast_hdr_t;
+
+/*!
+ * @brief  adpd7000 broadcast ring reader slot, one cache line each
+ */
+typedef struct
+{
+    uint32_t active;                                            /*!< 1 - slot used by a reader */
+    uint32_t tail;                                              /*!< Read index, written by reader only */
+    uint8_t  pad[ADPD7000_CACHE_LINE_SIZE - 8];
+} adi_adpd7000_bcast_slot_t;
+
+/*!
+ * @brief  adpd7000 broadcast ring publisher, local to the publishing process
+ */
+typedef struct
+{
+    adi_adpd7000_bcast_hdr_t *hdr;                              /*!< Shared region header */
+    adi_adpd7000_bcast_slot_t *slot;                            /*!< Reader slots */
+    uint8_t  *data;                                             /*!< Element storage */
+    uint32_t min_tail;                                          /*!< Slowest reader tail at last scan */
+    adi_adpd7000_bcast_notify notify;                           /*!< Notify function, NULL if not used */
+    void *user_data;                                            /*!< User data passed to notify function */
+} adi_adpd7000_bcast_t;
+
+/*!
+ * @brief  adpd7000 broadcast ring reader, local to the reading process
+ */
+typedef struct
+{
+    adi_adpd7000_bcast_hdr_t *hdr;                              /*!< Shared region header */
+    adi_adpd7000_bcast_slot_t *slot;                            /*!< Own reader slot */
+    const uint8_t *data;                                        /*!< Element storage */
+} adi_adpd7000_bcast_reader_t;
+
+/**
+ * @brief  Aligned frame callback function.
+ *
+ * @param  user_data    Pointer to user data registered with aligner
+ * @param  time_us      Time of aligned frame, same time base as channel offsets, unit: us
+ * @param  values       Channel values interpolated at time_us, in channel order
+ * @param  channel_num  Channel number
+ */
+typedef void (*adi_adpd7000_align_cb)(void *user_data, double time_us, const double *values, uint8_t channel_num);
+
+/*!
+ * @brief  adpd7000 aligner channel, one sampled signal
+ */
+typedef struct
+{
+    double   period;                                            /*!< Sample period, unit: us */
+    double   offset;                                            /*!< Time of first sample, unit: us */
+    double   hist[4];                                           /*!< Last 4 samples, indexed by sample number & 3 */
+    uint64_t count;                                             /*!< Samples pushed */
+    uint64_t next_out;                                          /*!< Next aligned output to compute */
+    double   out[ADPD7000_ALIGN_QUEUE];                         /*!< Computed outputs not emitted yet */
+} adi_adpd7000_align_channel_t;
+
+/*!
+ * @brief  adpd7000 multi-rate aligner, resamples channels onto one output timeline
+ */
+typedef struct
+{
+    double   out_period;                                        /*!< Output period, unit: us */
+    double   start;                                             /*!< Time of first output, unit: us */
+    uint8_t  channel_num;                                       /*!< Channel number */
+    uint64_t emitted;                                           /*!< Outputs emitted or dropped */
+    uint32_t drop_count;                                        /*!< Outputs dropped because a channel ran a queue ahead */
+    adi_adpd7000_align_cb cb;                                   /*!< Aligned frame callback */
+    void *user_data;                                            /*!< User data passed to callback */
+    double   values[ADPD7000_ALIGN_MAX_CHANNEL];                /*!< Aligned frame being emitted */
+    adi_adpd7000_align_channel_t channel[ADPD7000_ALIGN_MAX_CHANNEL]; /*!< Channels */
+} adi_adpd7000_align_t;
+
+/*!
+ * @brief  adpd7000 polling drain scheduler, learns FIFO fill rate to predict when a batch is ready
+ */
+typedef struct
+{
+    uint32_t sequence_size;                                     /*!< Size of data in FIFO during a sequence */
+    uint32_t batch_size;                                        /*!< Bytes to wait for, whole sequences */
+    double   alpha;                                             /*!< Weight of a new rate sample, 0 ~ 1 */
+    double   rate;                                              /*!< Fill rate, unit: byte/us */
+    uint8_t  valid;                                             /*!< 1 - last observation valid */
+    uint8_t  outlier;                                           /*!< Consecutive rate samples far from fill rate */
+    int64_t  last_us;                                           /*!< Host time of last observation, unit: us */
+    uint32_t last_count;                                        /*!< FIFO bytes at last observation less bytes read since */
+    int64_t  window_us;                                         /*!< Host time rate sample window started, unit: us */
+    uint32_t window_size;                                       /*!< Bytes written to FIFO since window started */
+    uint32_t reset_count;                                       /*!< Rate changes detected */
+} adi_adpd7000_sched_t;
+
+/**
+ * @brief  Capture write function.
+ *
+ * @param  user_data    Pointer to user data, usually handle to a file
+ * @param  data         Pointer to data to append
+ * @param  len          Length to write, in bytes
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+typedef int32_t (*adi_adpd7000_capture_write)(void *user_data, const uint8_t *data, uint32_t len);
+
+/*!
+ * @brief  adpd7000 capture chunk index entry
+ */
+typedef struct
+{
+    uint64_t offset;                                            /*!< Chunk offset from start of capture */
+    uint64_t first_seq;                                         /*!< Index of first sequence in chunk */
+} adi_adpd7000_capture_index_t;
+
+/*!
+ * @brief  adpd7000 capture writer
+ */
+typedef struct
+{
+    adi_adpd7000_capture_write write;                           /*!< Function pointer to write function */
+    void *user_data;                                            /*!< User data passed to write function */
+    adi_adpd7000_fifo_config_t fifo;                            /*!< Sequence fifo configuration of capture */
+    uint64_t offset;                                            /*!< Bytes written */
+    uint64_t seq_total;                                         /*!< Sequences written */
+    adi_adpd7000_capture_index_t *index;                        /*!< Chunk index storage */
+    uint32_t index_capacity;                                    /*!< Chunk index capacity */
+    uint32_t chunk_count;                                       /*!< Chunks written */
+} adi_adpd7000_capture_writer_t;
+
+/*!
+ * @brief  adpd7000 capture reader, works in place on a memory mapped capture
+ */
+typedef struct
+{
+    const uint8_t *base;                                        /*!< Start of capture */
+    size_t   size;                                              /*!< Capture size in bytes */
+    adi_adpd7000_fifo_config_t fifo;                            /*!< Sequence fifo configuration of capture */
+    uint32_t slot_freq;                                         /*!< Timeslot frequency, unit: Hz */
+    uint32_t ts_clk;                                            /*!< Timestamp counter clock, unit: Hz */
+    uint16_t reg_num;                                           /*!< Register number in snapshot */
+    const uint8_t *regs;                                        /*!< Register snapshot */
+    const uint8_t *index;                                       /*!< Chunk index */
+    uint32_t chunk_count;                                       /*!< Chunk number */
+    uint64_t seq_total;                                         /*!< Sequence number in capture */
+} adi_adpd7000_capture_reader_t;
+
+/*!
+ * @brief  adpd7000 capture chunk
+ */
+typedef struct
+{
+    const uint8_t *data;                                        /*!< Raw FIFO bytes, starts on a sequence boundary */
+    uint32_t size;                                              /*!< Raw FIFO bytes size */
+    uint32_t seq_count;                                         /*!< Sequence number in chunk */
+    uint64_t first_seq;                                         /*!< Index of first sequence in chunk */
+    uint32_t stamp;                                             /*!< Device timestamp captured with chunk */
+    uint16_t delta;                                             /*!< Timeslot delta captured with chunk */
+} adi_adpd7000_capture_chunk_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -784,6 +1331,30 @@ int32_t adi_adpd7000_hal_log_write(adi_adpd7000_device_t *device, uint32_t log_t
  */
 int32_t adi_adpd7000_hal_fifo_read_bytes(adi_adpd7000_device_t *device, uint32_t reg_addr, uint8_t *reg_data, uint32_t len);
 
+/**
+ * @brief  HAL register block read function, consecutive registers in one bus transaction.
+ *         
+ * @param  device     Pointer to device structure
+ * @param  reg_addr   First register address to read
+ * @param  reg_data   Pointer to save readback data, reg_num values
+ * @param  reg_num    Register number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_hal_reg_read_block(adi_adpd7000_device_t *device, uint32_t reg_addr, uint16_t *reg_data, uint32_t reg_num);
+
+/**
+ * @brief  HAL register block write function, consecutive registers in bursts of up to (ADPD7000_SDK_MAX_BUFSIZE - 2) / 2 registers.
+ *         
+ * @param  device     Pointer to device structure
+ * @param  reg_addr   First register address to write
+ * @param  reg_data   Pointer to data to write, reg_num values
+ * @param  reg_num    Register number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_hal_reg_write_block(adi_adpd7000_device_t *device, uint32_t reg_addr, const uint16_t *reg_data, uint32_t reg_num);
+
 /**
  * @brief  Get device id and device revision
  *         
@@ -862,6 +1433,33 @@ int32_t adi_adpd7000_device_clr_fifo(adi_adpd7000_device_t *device);
  */
 int32_t adi_adpd7000_device_set_fifo_threshold(adi_adpd7000_device_t *device, uint16_t threshold);
 
+/**
+ * @brief  Set FIFO threshold to the largest whole number of sequences that leaves
+ *         room for the data arriving during the host wake up latency
+ *         
+ * @param  device     Pointer to device structure
+ * @param  fifo       @see adi_adpd7000_fifo_config_t
+ * @param  freq       Timeslot frequency, unit: Hz
+ * @param  latency_us Worst case host wake up latency, unit: us
+ * @param  threshold  Pointer to threshold written, pass NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_device_set_fifo_threshold_auto(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, uint32_t freq, uint32_t latency_us, uint16_t *threshold);
+
+/**
+ * @brief  Read sequence fifo configuration and timeslot frequency, re-tune FIFO threshold if either changed.
+ *         Call it after any change of slot, FIFO data size or timeslot frequency.
+ *         
+ * @param  device     Pointer to device structure
+ * @param  tune       @see adi_adpd7000_fifo_tune_t, sys_clk and latency_us set by caller, 
+ *                    other fields zeroed before first call
+ * @param  fifo       @see adi_adpd7000_fifo_config_t, updated sequence fifo configuration
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_device_update_fifo_threshold(adi_adpd7000_device_t *device, adi_adpd7000_fifo_tune_t *tune, adi_adpd7000_fifo_config_t *fifo);
+
 /**
  * @brief  Clear FIFO
  *         
@@ -913,6 +1511,19 @@ int32_t adi_adpd7000_device_fifo_get_fifo_int_status(adi_adpd7000_device_t *devi
  */
 int32_t adi_adpd7000_device_enable_fifo_thres_interrupt(adi_adpd7000_device_t *device, adi_adpd7000_interrupt_type_e type, bool enable);
 
+/**
+ * @brief  Enable/disable PPG data ready interrupt of a slot, raised when the slot's level 0 data registers are updated,
+ *         @see adi_adpd7000_ppg_read_latest
+ *         
+ * @param  device     Pointer to device structure
+ * @param  type       @see adi_adpd7000_interrupt_type_e
+ * @param  slot       PPG slot, 0 ~ ADPD7000_PPG_MAX_SLOT - 1
+ * @param  enable     false - disable data ready interrput, true - enable data ready interrput
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_device_enable_ppg_data_ready_interrupt(adi_adpd7000_device_t *device, adi_adpd7000_interrupt_type_e type, uint8_t slot, bool enable);
+
 /**
  * @brief  Enable/disable automatic clearing of the FIFO threshold interrupt each time the FIFO is read.
  *         
@@ -974,6 +1585,17 @@ int32_t adi_adpd7000_device_config_ext_clock(adi_adpd7000_device_t *device, adi_
  */
 int32_t adi_adpd7000_device_set_slot_freq(adi_adpd7000_device_t *device, uint32_t sys_clk, uint32_t freq);
 
+/**
+ * @brief  Get timeslot frequency
+ *         
+ * @param  device     Pointer to device structure
+ * @param  sys_clk    System clock
+ * @param  freq       Pointer to timeslot frequency, unit: Hz
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_device_get_slot_freq(adi_adpd7000_device_t *device, uint32_t sys_clk, uint32_t *freq);
+
 /**
  * @brief  Enable/disable sleep mode, if sleep mode, chip is in sleep before first timeslot sequence on GO mode
  *         
@@ -1538,6 +2160,19 @@ int32_t adi_adpd7000_ppg_read_fifo(adi_adpd7000_device_t *device, adi_adpd7000_f
  */
 int32_t adi_adpd7000_ppg_read_struct_fifo(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_slot_data_t *signal_data, adi_adpd7000_ppg_slot_data_t *dark_data, adi_adpd7000_ppg_slot_data_t *lit_data, uint8_t *slot_num);
 
+/**
+ * @brief  Read latest PPG result of slot A and/or B from data registers in one block read, bypassing FIFO.
+ *         Call it on data ready, @see adi_adpd7000_device_enable_ppg_data_ready_interrupt, values are overwritten by the next sample of the slot.
+ *         
+ * @param  device            Pointer to device structure
+ * @param  slot_mask         bit0 - slot A, bit1 - slot B
+ * @param  signal_data       Pointer to PPG signal data, ADPD7000_PPG_LATEST_SLOT entries indexed by slot, channel 1 and 2
+ * @param  dark_data         Pointer to PPG dark data, ADPD7000_PPG_LATEST_SLOT entries indexed by slot, if null, do not output the data
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ppg_read_latest(adi_adpd7000_device_t *device, uint8_t slot_mask, adi_adpd7000_ppg_slot_data_t *signal_data, adi_adpd7000_ppg_slot_data_t *dark_data);
+
 /**
  * @brief  Init AGC configuration, fifo and ppg_cfg should be initilized before calling the function
  *         
@@ -1562,20 +2197,71 @@ int32_t adi_adpd7000_ppg_agc_init(adi_adpd7000_device_t *device, adi_adpd7000_fi
 int32_t adi_adpd7000_ppg_agc_process(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_agc_cfg_t *ppg_cfg, uint32_t *signal_data);
 
 /**
- * @brief  Set BioZ time slot num.
+ * @brief  Init AGC engine, reads the current gain, LED current, full scale and subsample ratio of every slot.
+ *         fifo and ppg_cfg should be initilized before calling the function
  *         
- * @param  device     Pointer to device structure
- * @param  num       @see adi_adpd7000_bioz_slot_num_e
+ * @param  device            Pointer to device structure
+ * @param  agc               @see adi_adpd7000_agc_t
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  ppg_cfg           @see adi_adpd7000_ppg_agc_cfg_t, copied into the engine
  *
  * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
  */
-int32_t adi_adpd7000_bioz_enable_slot(adi_adpd7000_device_t *device, adi_adpd7000_bioz_slot_num_e num);
+int32_t adi_adpd7000_agc_init(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_agc_cfg_t *ppg_cfg);
 
 /**
- * @brief  Get BioZ aviable channels number
+ * @brief  AGC engine process function, call it once per FIFO sequence. A decimated slot takes one sample every
+ *         subsample ratio sequences, and each slot updates its gain when its own average completes.
  *         
- * @param  device      Pointer to device structure
- * @param  slot_num    Pointer to channel number
+ * @param  device            Pointer to device structure
+ * @param  agc               @see adi_adpd7000_agc_t
+ * @param  signal_data       PPG signal data of the sequence indexed by slot, e.g. ppg_signal of @see adi_adpd7000_frame_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_agc_process(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc, const adi_adpd7000_ppg_slot_data_t *signal_data);
+
+/**
+ * @brief  Set AGC gain update mode, API_ADPD7000_AGC_UPDATE_RESTART after adi_adpd7000_agc_init.
+ *         In API_ADPD7000_AGC_UPDATE_BURST mode the sequencer keeps running and no FIFO data is dropped, call
+ *         adi_adpd7000_agc_apply after processing every sequence read from FIFO. new_gain of @see adi_adpd7000_agc_t
+ *         marks the first sample at the new gain, samples before it are not averaged.
+ *         
+ * @param  agc               @see adi_adpd7000_agc_t
+ * @param  mode              @see adi_adpd7000_agc_update_e
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_agc_set_update_mode(adi_adpd7000_agc_t *agc, adi_adpd7000_agc_update_e mode);
+
+/**
+ * @brief  Write gains decided by adi_adpd7000_agc_process in API_ADPD7000_AGC_UPDATE_BURST mode. Waits for the FIFO
+ *         to reach a sequence boundary, writes TIA gain to LED current registers of each slot in one burst, and
+ *         counts the sequences in FIFO still at the old gain.
+ *         
+ * @param  device            Pointer to device structure
+ * @param  agc               @see adi_adpd7000_agc_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_TIMEOUT if no sequence boundary was seen, nothing is
+ *         written and the gains stay pending for the next call, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_agc_apply(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc);
+
+/**
+ * @brief  Set BioZ time slot num.
+ *         
+ * @param  device     Pointer to device structure
+ * @param  num       @see adi_adpd7000_bioz_slot_num_e
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bioz_enable_slot(adi_adpd7000_device_t *device, adi_adpd7000_bioz_slot_num_e num);
+
+/**
+ * @brief  Get BioZ aviable channels number
+ *         
+ * @param  device      Pointer to device structure
+ * @param  slot_num    Pointer to channel number
  *
  * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
  */
@@ -1946,6 +2632,991 @@ int32_t adi_adpd7000_gpio_get_input(adi_adpd7000_device_t *device, uint8_t index
  */
 int32_t adi_adpd7000_device_clr_fifo_int(adi_adpd7000_device_t *device);
 
+/**
+ * @brief  Decode one FIFO sequence from a buffer into a frame, no bus access
+ *         
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  data              Pointer to sequence data, fifo->sequence_size bytes
+ * @param  frame             @see adi_adpd7000_frame_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_decode_frame(adi_adpd7000_fifo_config_t *fifo, const uint8_t *data, adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Read one FIFO sequence with a single bus read and decode ECG, PPG and BioZ data
+ *         
+ * @param  device            Pointer to device structure
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  frame             @see adi_adpd7000_frame_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_read_frame(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Read status bytes at the end of a sequence, call it after the ECG, PPG and BioZ
+ *         FIFO read functions when status bytes are enabled
+ *         
+ * @param  device            Pointer to device structure
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  status            @see adi_adpd7000_fifo_status_bytes_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_read_status_bytes(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_status_bytes_t *status);
+
+/**
+ * @brief  Check sequence number and report sequences lost since the previous one.
+ *         Sequence number is 8 bits, a gap of 256 sequences or more can not be detected.
+ *         
+ * @param  track             @see adi_adpd7000_fifo_seq_track_t, zeroed before first call
+ * @param  seq_num           Sequence number of the current sequence
+ * @param  lost              Pointer to lost sequence number, pass NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_check_seq_num(adi_adpd7000_fifo_seq_track_t *track, uint8_t seq_num, uint32_t *lost);
+
+/**
+ * @brief  Plan the transfers of a drain from a FIFO status register value, shared by the drain APIs and
+ *         asynchronous drivers. On underflow the partial sequence at the FIFO head is discarded, on overflow
+ *         the partial sequence at the FIFO tail once every whole sequence before it is read. If max_seq stops
+ *         short of it, track remembers where the cut is and later plans discard exactly its bytes, without
+ *         track the sequences before it are discarded too. track is updated as if the plan is carried out.
+ *         
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  track             @see adi_adpd7000_fifo_seq_track_t, NULL if none
+ * @param  status            FIFO status register, byte count after any data already read
+ * @param  max_seq           Whole sequences the buffer takes
+ * @param  plan              @see adi_adpd7000_fifo_plan_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_plan_drain(adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_seq_track_t *track, uint16_t status,
+    uint16_t max_seq, adi_adpd7000_fifo_plan_t *plan);
+
+/**
+ * @brief  Drain whole sequences from FIFO and recover from overflow or underflow.
+ *         On overflow the partial sequence at the FIFO tail is discarded, on underflow the
+ *         partial sequence at the FIFO head is discarded, then the flags are cleared.
+ *         If the buffer can not take every whole sequence before the cut one, track keeps its
+ *         position and a later drain discards it, @see adi_adpd7000_fifo_plan_drain.
+ *         
+ * @param  device            Pointer to device structure
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  track             @see adi_adpd7000_fifo_seq_track_t, keeps sequence number and overflow cut across drains,
+ *                           zeroed before first drain, pass NULL if not needed
+ * @param  data              Pointer to buffer for sequence data
+ * @param  size              Buffer size in bytes, at least fifo->sequence_size
+ * @param  drain             @see adi_adpd7000_fifo_drain_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_drain(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_seq_track_t *track,
+    uint8_t *data, uint32_t size, adi_adpd7000_fifo_drain_t *drain);
+
+/**
+ * @brief  Drain with fewer bus transactions. Sequences known to be in FIFO are read first without
+ *         a byte count read, one status read then gives what arrived meanwhile for a follow up read,
+ *         and error flags are cleared together with the threshold interrupt in one write.
+ *         If the prediction was wrong the speculative data is discarded and counted as lost.
+ *         
+ * @param  device            Pointer to device structure
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  track             @see adi_adpd7000_fifo_seq_track_t, keeps sequence number and overflow cut across drains,
+ *                           zeroed before first drain, pass NULL if not needed
+ * @param  data              Pointer to buffer for sequence data
+ * @param  size              Buffer size in bytes, at least fifo->sequence_size
+ * @param  predict           Bytes known to be in FIFO, e.g. FIFO threshold + 1 on threshold interrupt, 0 if unknown
+ * @param  clr_int           true - clear FIFO threshold interrupt
+ * @param  drain             @see adi_adpd7000_fifo_drain_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_drain_fused(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_seq_track_t *track,
+    uint8_t *data, uint32_t size, uint16_t predict, bool clr_int, adi_adpd7000_fifo_drain_t *drain);
+
+/**
+ * @brief  Get byte size of every value in a sequence, in FIFO order: ECG samples (status byte included),
+ *         PPG signal, dark and lit per slot and channel (sizes of 0 skipped), BioZ real and imag per slot,
+ *         then enabled status bytes fields
+ *         
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  sizes             Pointer to value sizes, ADPD7000_FIFO_MAX_COLUMN entries hold any layout
+ * @param  capacity          Entries in sizes
+ * @param  num               Pointer to value number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_INVALID_PARAM if more than capacity values, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_get_column_sizes(adi_adpd7000_fifo_config_t *fifo, uint8_t *sizes, uint16_t capacity, uint16_t *num);
+
+/**
+ * @brief  Init view over raw FIFO data, the data is not copied and must outlive the view
+ *         
+ * @param  view              @see adi_adpd7000_fifo_view_t
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  data              FIFO data starting at a sequence
+ * @param  size              Size of FIFO data, trailing partial sequence is ignored
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_view_init(adi_adpd7000_fifo_view_t *view, adi_adpd7000_fifo_config_t *fifo, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief  Get view of ECG samples of all sequences, filler samples included, @see adi_adpd7000_fifo_view_ecg_status
+ *         
+ * @param  view              @see adi_adpd7000_fifo_view_t
+ * @param  column            @see adi_adpd7000_column_view_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_view_ecg(adi_adpd7000_fifo_view_t *view, adi_adpd7000_column_view_t *column);
+
+/**
+ * @brief  Get view of ECG status bytes of all sequences, 0xff marks a filler sample, reads 0 if status byte disabled
+ *         
+ * @param  view              @see adi_adpd7000_fifo_view_t
+ * @param  column            @see adi_adpd7000_column_view_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_view_ecg_status(adi_adpd7000_fifo_view_t *view, adi_adpd7000_column_view_t *column);
+
+/**
+ * @brief  Get view of one PPG value of all sequences
+ *         
+ * @param  view              @see adi_adpd7000_fifo_view_t
+ * @param  slot              PPG slot index
+ * @param  channel           Channel 0 or 1
+ * @param  field             @see adi_adpd7000_ppg_field_e
+ * @param  column            @see adi_adpd7000_column_view_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_view_ppg(adi_adpd7000_fifo_view_t *view, uint8_t slot, uint8_t channel, adi_adpd7000_ppg_field_e field,
+    adi_adpd7000_column_view_t *column);
+
+/**
+ * @brief  Get view of one BioZ value of all sequences
+ *         
+ * @param  view              @see adi_adpd7000_fifo_view_t
+ * @param  slot              BioZ slot index
+ * @param  imag              false - real part, true - imaginary part
+ * @param  column            @see adi_adpd7000_column_view_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_fifo_view_bioz(adi_adpd7000_fifo_view_t *view, uint8_t slot, bool imag, adi_adpd7000_column_view_t *column);
+
+/**
+ * @brief  Decode one value of a column view
+ *         
+ * @param  column            @see adi_adpd7000_column_view_t
+ * @param  index             Value index, 0 is the oldest
+ * @param  value             Pointer to value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_column_get(const adi_adpd7000_column_view_t *column, uint32_t index, uint32_t *value);
+
+/**
+ * @brief  Configure timestamp capture
+ *         
+ * @param  device            Pointer to device structure
+ * @param  gpio              Gpio index from 0 ~ 3 used to capture timestamp
+ * @param  always_en         0 - counter runs in go mode only, 1 - counter always runs
+ * @param  inv               0 - capture on rising edge, 1 - capture on falling edge
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_config(adi_adpd7000_device_t *device, uint8_t gpio, bool always_en, bool inv);
+
+/**
+ * @brief  Enable timestamp capture
+ *         
+ * @param  device            Pointer to device structure
+ * @param  enable            true - enable, false - disable
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_enable_capture(adi_adpd7000_device_t *device, bool enable);
+
+/**
+ * @brief  Read captured timestamp and the delta from last timeslot start to capture
+ *         
+ * @param  device            Pointer to device structure
+ * @param  stamp             Pointer to captured timestamp
+ * @param  delta             Pointer to timeslot delta, pass NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_read(adi_adpd7000_device_t *device, uint32_t *stamp, uint16_t *delta);
+
+/**
+ * @brief  Init timestamp correlation state
+ *         
+ * @param  sync              @see adi_adpd7000_ts_sync_t
+ * @param  clk_freq          Timestamp counter clock, unit: Hz
+ * @param  forget            Forgetting factor, 0 < forget <= 1, e.g. 0.999 to track slow drift change
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_sync_init(adi_adpd7000_ts_sync_t *sync, uint32_t clk_freq, double forget);
+
+/**
+ * @brief  Add one device timestamp / host time pair to the linear fit
+ *         
+ * @param  sync              @see adi_adpd7000_ts_sync_t
+ * @param  stamp             Raw timestamp captured on GPIO edge
+ * @param  host_us           Host time of the same GPIO edge, unit: us
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_sync_update(adi_adpd7000_ts_sync_t *sync, uint32_t stamp, int64_t host_us);
+
+/**
+ * @brief  Read captured timestamp and add it with the host time of the capture edge to the linear fit,
+ *         call it at each FIFO drain after asserting the timestamp GPIO
+ *         
+ * @param  device            Pointer to device structure
+ * @param  sync              @see adi_adpd7000_ts_sync_t
+ * @param  host_us           Host time of the capture edge, unit: us
+ * @param  stamp             Pointer to captured timestamp, pass NULL if not needed
+ * @param  delta             Pointer to timeslot delta, pass NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_capture(adi_adpd7000_device_t *device, adi_adpd7000_ts_sync_t *sync, int64_t host_us, uint32_t *stamp, uint16_t *delta);
+
+/**
+ * @brief  Convert raw timestamp to host time, timestamp must be within 2^31 counts of the last capture
+ *         
+ * @param  sync              @see adi_adpd7000_ts_sync_t
+ * @param  stamp             Raw timestamp
+ * @param  host_us           Pointer to host time, unit: us
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_to_host(adi_adpd7000_ts_sync_t *sync, uint32_t stamp, int64_t *host_us);
+
+/**
+ * @brief  Get host time of a sequence drained with a timestamp capture
+ *         
+ * @param  sync              @see adi_adpd7000_ts_sync_t
+ * @param  stamp             Raw timestamp captured at the drain
+ * @param  delta             Timeslot delta captured at the drain
+ * @param  period            Sequence period in timestamp counts
+ * @param  seq_count         Number of sequences drained
+ * @param  index             Sequence index in the drain, 0 is the oldest
+ * @param  host_us           Pointer to host time of sequence start, unit: us
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_timestamp_get_sequence_time(adi_adpd7000_ts_sync_t *sync, uint32_t stamp, uint16_t delta, uint32_t period,
+    uint16_t seq_count, uint16_t index, int64_t *host_us);
+
+/**
+ * @brief  Build sequence schedule from timeslot pulse timing. Timeslots with zero offset start right after
+ *         the previous one, a PPG sample is taken at the middle of its pulse train.
+ *         
+ * @param  schedule          @see adi_adpd7000_schedule_t
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  seq_period        Sequence period, unit: us
+ * @param  ppg               PPG timeslot timing, fifo->ppg_slot entries, @see adi_adpd7000_schedule_slot_t
+ * @param  bioz              BioZ timeslot timing, fifo->bioz_slot entries, NULL if no BioZ timeslot
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_schedule_init(adi_adpd7000_schedule_t *schedule, adi_adpd7000_fifo_config_t *fifo, double seq_period,
+    const adi_adpd7000_schedule_slot_t *ppg, const adi_adpd7000_schedule_slot_t *bioz);
+
+/**
+ * @brief  Read timeslot period, offsets, LED pulse timing and subsample ratios and build sequence schedule
+ *         
+ * @param  device            Pointer to device structure
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  sys_clk           System clock, unit: Hz
+ * @param  schedule          @see adi_adpd7000_schedule_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_schedule_read(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, uint32_t sys_clk,
+    adi_adpd7000_schedule_t *schedule);
+
+/**
+ * @brief  Stamp each sample of a frame with host time, use schedule->ppg and schedule->bioz as
+ *         offset_us of adi_adpd7000_align_add_channel. Frames are stamped in order from go, a subsampled
+ *         slot is stamped at its last run. Add lost sequences to schedule->seq_index to keep the subsample phase.
+ *         
+ * @param  schedule          @see adi_adpd7000_schedule_t
+ * @param  frame             @see adi_adpd7000_frame_t
+ * @param  seq_us            Host time of sequence start, @see adi_adpd7000_timestamp_get_sequence_time
+ * @param  time              @see adi_adpd7000_frame_time_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_schedule_stamp_frame(adi_adpd7000_schedule_t *schedule, const adi_adpd7000_frame_t *frame, int64_t seq_us,
+    adi_adpd7000_frame_time_t *time);
+
+/**
+ * @brief  Init stream
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ * @param  device            Pointer to device structure
+ * @param  int_type          @see adi_adpd7000_interrupt_type_e
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_init(adi_adpd7000_stream_t *stream, adi_adpd7000_device_t *device, adi_adpd7000_interrupt_type_e int_type);
+
+/**
+ * @brief  Register stream callbacks, pass NULL for callbacks not used
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ * @param  user_data         Pointer to user data passed to callbacks
+ * @param  frame_cb          @see adi_adpd7000_stream_frame_cb
+ * @param  ecg_cb            @see adi_adpd7000_stream_ecg_cb, called if ECG samples in frame
+ * @param  ppg_cb            @see adi_adpd7000_stream_ppg_cb, called if PPG slots in frame
+ * @param  bioz_cb           @see adi_adpd7000_stream_bioz_cb, called if BioZ slots in frame
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_set_callbacks(adi_adpd7000_stream_t *stream, void *user_data, adi_adpd7000_stream_frame_cb frame_cb,
+    adi_adpd7000_stream_ecg_cb ecg_cb, adi_adpd7000_stream_ppg_cb ppg_cb, adi_adpd7000_stream_bioz_cb bioz_cb);
+
+/**
+ * @brief  Decode frames into pool blocks and pass them to pool callback, pass NULL to stop using pool.
+ *         Pool must hold the frames of a full FIFO at stream start, @see adi_adpd7000_frame_pool_get_block_num
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ * @param  pool              @see adi_adpd7000_frame_pool_t
+ * @param  pool_cb           @see adi_adpd7000_stream_pool_cb
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_set_pool(adi_adpd7000_stream_t *stream, adi_adpd7000_frame_pool_t *pool, adi_adpd7000_stream_pool_cb pool_cb);
+
+/**
+ * @brief  Start stream, read sequence fifo configuration, clear FIFO, enable FIFO threshold interrupt and go
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_start(adi_adpd7000_stream_t *stream);
+
+/**
+ * @brief  Stop stream, disable FIFO threshold interrupt and stop
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_stop(adi_adpd7000_stream_t *stream);
+
+/**
+ * @brief  Re-tune FIFO threshold of a running stream, @see adi_adpd7000_device_update_fifo_threshold.
+ *         Use it instead of the device API so the stream reloads its sequence fifo configuration and the
+ *         bytes it reads speculatively on the next interrupt.
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ * @param  tune              @see adi_adpd7000_fifo_tune_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_update_fifo_threshold(adi_adpd7000_stream_t *stream, adi_adpd7000_fifo_tune_t *tune);
+
+/**
+ * @brief  Stream interrupt entry point, call it from task context when FIFO interrupt fired.
+ *         Drain whole sequences, decode them, clear interrupt and deliver frames to callbacks.
+ *         Sequences above FIFO threshold are read speculatively, @see adi_adpd7000_fifo_drain_fused
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_irq_handler(adi_adpd7000_stream_t *stream);
+
+/**
+ * @brief  Get stream statistics
+ *         
+ * @param  stream            @see adi_adpd7000_stream_t
+ * @param  stats             @see adi_adpd7000_stream_stats_t
+ * @param  reset             true - reset statistics after read
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_stream_get_stats(adi_adpd7000_stream_t *stream, adi_adpd7000_stream_stats_t *stats, bool reset);
+
+/**
+ * @brief  Init single producer single consumer ring
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ * @param  buf               Pointer to element storage, capacity * elem_size bytes
+ * @param  elem_size         Element size in bytes, e.g. sizeof(adi_adpd7000_frame_t) or fifo->sequence_size
+ * @param  capacity          Element number, power of 2
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_init(adi_adpd7000_ring_t *ring, void *buf, uint32_t elem_size, uint32_t capacity);
+
+/**
+ * @brief  Reserve next element for writing, producer only, no copy
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ * @param  elem              Pointer to reserved element, fill it then call adi_adpd7000_ring_commit
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_FULL if full, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_reserve(adi_adpd7000_ring_t *ring, void **elem);
+
+/**
+ * @brief  Publish reserved element to consumer, producer only
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_commit(adi_adpd7000_ring_t *ring);
+
+/**
+ * @brief  Copy element into ring, producer only, element is dropped and counted if ring full
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ * @param  elem              Pointer to element
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_FULL if full, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_push(adi_adpd7000_ring_t *ring, const void *elem);
+
+/**
+ * @brief  Get oldest element without removing it, consumer only, no copy
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ * @param  elem              Pointer to oldest element, call adi_adpd7000_ring_release when done
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_EMPTY if empty, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_peek(adi_adpd7000_ring_t *ring, void **elem);
+
+/**
+ * @brief  Release oldest element to producer, consumer only
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_release(adi_adpd7000_ring_t *ring);
+
+/**
+ * @brief  Copy oldest element out of ring, consumer only
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ * @param  elem              Pointer to element
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_EMPTY if empty, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_pop(adi_adpd7000_ring_t *ring, void *elem);
+
+/**
+ * @brief  Get ring statistics, counters are written by producer, read them from any context
+ *         
+ * @param  ring              @see adi_adpd7000_ring_t
+ * @param  count             Pointer to current element count, pass NULL if not needed
+ * @param  high_water        Pointer to max element count, pass NULL if not needed
+ * @param  drop_count        Pointer to dropped element count, pass NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_ring_get_stats(adi_adpd7000_ring_t *ring, uint32_t *count, uint32_t *high_water, uint32_t *drop_count);
+
+/**
+ * @brief  Stream frame callback pushing frames into a ring, register it with ring as user_data,
+ *         ring element size must be sizeof(adi_adpd7000_frame_t)
+ *
+ * @param  user_data         Pointer to @see adi_adpd7000_ring_t
+ * @param  frame             Decoded frame
+ */
+void adi_adpd7000_ring_frame_cb(void *user_data, const adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Init capture writer
+ *         
+ * @param  writer            @see adi_adpd7000_capture_writer_t
+ * @param  write             @see adi_adpd7000_capture_write
+ * @param  user_data         Pointer to user data passed to write function
+ * @param  index             Pointer to chunk index storage, kept until adi_adpd7000_capture_close
+ * @param  index_capacity    Max chunk number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_writer_init(adi_adpd7000_capture_writer_t *writer, adi_adpd7000_capture_write write, void *user_data,
+    adi_adpd7000_capture_index_t *index, uint32_t index_capacity);
+
+/**
+ * @brief  Write capture header with sequence fifo configuration and register snapshot
+ *         
+ * @param  writer            @see adi_adpd7000_capture_writer_t
+ * @param  device            Pointer to device structure, registers are read from it
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  reg_addr          Pointer to register addresses to snapshot
+ * @param  reg_num           Register number
+ * @param  slot_freq         Timeslot frequency, unit: Hz
+ * @param  ts_clk            Timestamp counter clock, unit: Hz
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_write_header(adi_adpd7000_capture_writer_t *writer, adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo,
+    const uint16_t *reg_addr, uint16_t reg_num, uint32_t slot_freq, uint32_t ts_clk);
+
+/**
+ * @brief  Write a chunk of raw FIFO bytes
+ *         
+ * @param  writer            @see adi_adpd7000_capture_writer_t
+ * @param  data              Pointer to raw FIFO bytes, starts on a sequence boundary
+ * @param  size              Size in bytes, multiple of sequence size
+ * @param  stamp             Device timestamp captured with the drain
+ * @param  delta             Timeslot delta captured with the drain
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_FULL if index full, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_write_chunk(adi_adpd7000_capture_writer_t *writer, const uint8_t *data, uint32_t size, uint32_t stamp, uint16_t delta);
+
+/**
+ * @brief  Write chunk index and trailer, capture is complete after it
+ *         
+ * @param  writer            @see adi_adpd7000_capture_writer_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_close(adi_adpd7000_capture_writer_t *writer);
+
+/**
+ * @brief  Open a capture in memory, e.g. a memory mapped file. The FIFO layout in the header
+ *         must add up to its sequence size, otherwise the capture is rejected.
+ *         
+ * @param  reader            @see adi_adpd7000_capture_reader_t
+ * @param  base              Pointer to start of capture
+ * @param  size              Capture size in bytes
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_open(adi_adpd7000_capture_reader_t *reader, const void *base, size_t size);
+
+/**
+ * @brief  Get a register of the snapshot
+ *         
+ * @param  reader            @see adi_adpd7000_capture_reader_t
+ * @param  index             Register index, 0 ~ reg_num - 1
+ * @param  reg_addr          Pointer to register address
+ * @param  reg_data          Pointer to register value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_get_reg(adi_adpd7000_capture_reader_t *reader, uint16_t index, uint16_t *reg_addr, uint16_t *reg_data);
+
+/**
+ * @brief  Get a chunk in place
+ *         
+ * @param  reader            @see adi_adpd7000_capture_reader_t
+ * @param  index             Chunk index, 0 ~ chunk_count - 1
+ * @param  chunk             @see adi_adpd7000_capture_chunk_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_get_chunk(adi_adpd7000_capture_reader_t *reader, uint32_t index, adi_adpd7000_capture_chunk_t *chunk);
+
+/**
+ * @brief  Find the chunk holding a sequence
+ *         
+ * @param  reader            @see adi_adpd7000_capture_reader_t
+ * @param  seq               Sequence index in capture
+ * @param  index             Pointer to chunk index
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_seek(adi_adpd7000_capture_reader_t *reader, uint64_t seq, uint32_t *index);
+
+/**
+ * @brief  Split chunks of a capture into ranges of about equal sequence number, one per worker
+ *         
+ * @param  reader            @see adi_adpd7000_capture_reader_t
+ * @param  worker_num        Worker number
+ * @param  worker            Worker index, 0 ~ worker_num - 1
+ * @param  first_chunk       Pointer to first chunk of the worker
+ * @param  chunk_num         Pointer to chunk number of the worker, may be 0
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_split(adi_adpd7000_capture_reader_t *reader, uint32_t worker_num, uint32_t worker, uint32_t *first_chunk, uint32_t *chunk_num);
+
+/**
+ * @brief  Decode chunks into per-channel columns. Reentrant, workers can decode disjoint chunk
+ *         ranges of the same reader into the same columns in parallel.
+ *         Value c of sequence s is stored at columns[c * row_stride + s - row_base],
+ *         value order @see adi_adpd7000_fifo_get_column_sizes. ECG filler samples are skipped as in
+ *         adi_adpd7000_fifo_decode_frame, the ECG columns they leave at the end of the sequence hold ADPD7000_FIFO_ECG_FILLER.
+ *         
+ * @param  reader            @see adi_adpd7000_capture_reader_t
+ * @param  first_chunk       First chunk to decode
+ * @param  chunk_num         Chunk number to decode
+ * @param  columns           Pointer to column storage, column number * row_stride values
+ * @param  row_base          Sequence index stored at row 0
+ * @param  row_stride        Rows per column
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_capture_decode_columns(adi_adpd7000_capture_reader_t *reader, uint32_t first_chunk, uint32_t chunk_num,
+    uint32_t *columns, uint64_t row_base, uint64_t row_stride);
+
+/**
+ * @brief  Get pool block number holding frames of depth full FIFOs for a sequence fifo configuration
+ *         
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  depth             Full FIFOs consumers may hold at the same time, at least 1
+ * @param  block_num         Pointer to block number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_frame_pool_get_block_num(adi_adpd7000_fifo_config_t *fifo, uint32_t depth, uint32_t *block_num);
+
+/**
+ * @brief  Init frame pool, all blocks free
+ *         
+ * @param  pool              @see adi_adpd7000_frame_pool_t
+ * @param  block             Pointer to block storage
+ * @param  block_num         Block number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_frame_pool_init(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_pool_block_t *block, uint32_t block_num);
+
+/**
+ * @brief  Allocate frame with reference count 1, call from one context only
+ *         
+ * @param  pool              @see adi_adpd7000_frame_pool_t
+ * @param  frame             Pointer to allocated frame
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_EMPTY if no free block, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_frame_pool_alloc(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t **frame);
+
+/**
+ * @brief  Add a reference to frame, any context
+ *         
+ * @param  pool              @see adi_adpd7000_frame_pool_t
+ * @param  frame             Frame allocated from pool
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_frame_pool_retain(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Drop a reference to frame, frame is returned to pool with the last reference, any context
+ *         
+ * @param  pool              @see adi_adpd7000_frame_pool_t
+ * @param  frame             Frame allocated from pool
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_frame_pool_release(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Get frame pool statistics
+ *         
+ * @param  pool              @see adi_adpd7000_frame_pool_t
+ * @param  free_count        Pointer to free block number, NULL if not needed
+ * @param  low_water         Pointer to min free block number seen by allocator, NULL if not needed
+ * @param  fail_count        Pointer to failed allocations, NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_frame_pool_get_stats(adi_adpd7000_frame_pool_t *pool, uint32_t *free_count, uint32_t *low_water, uint32_t *fail_count);
+
+/**
+ * @brief  Init drain scheduler, fill rate starts from configured timeslot frequency
+ *         
+ * @param  sched             @see adi_adpd7000_sched_t
+ * @param  fifo              @see adi_adpd7000_fifo_config_t
+ * @param  slot_freq         Timeslot frequency, unit: Hz
+ * @param  batch             Sequences to wait for before waking up, (batch + 1) * sequence_size <= ADPD7000_FIFO_SIZE
+ * @param  alpha             Weight of a new rate sample, 0 ~ 1, smaller is smoother
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_sched_init(adi_adpd7000_sched_t *sched, adi_adpd7000_fifo_config_t *fifo, uint32_t slot_freq, uint16_t batch, double alpha);
+
+/**
+ * @brief  Restart fill rate from a new timeslot frequency, call it after adi_adpd7000_device_set_slot_freq
+ *         
+ * @param  sched             @see adi_adpd7000_sched_t
+ * @param  slot_freq         Timeslot frequency, unit: Hz
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_sched_set_slot_freq(adi_adpd7000_sched_t *sched, uint32_t slot_freq);
+
+/**
+ * @brief  Feed a FIFO byte count observation to scheduler
+ *         
+ * @param  sched             @see adi_adpd7000_sched_t
+ * @param  count             FIFO byte count
+ * @param  host_us           Host time when count was read, unit: us
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_sched_update(adi_adpd7000_sched_t *sched, uint16_t count, int64_t host_us);
+
+/**
+ * @brief  Read FIFO byte count and feed it to scheduler
+ *         
+ * @param  device            Pointer to device structure
+ * @param  sched             @see adi_adpd7000_sched_t
+ * @param  host_us           Host time of the read, unit: us
+ * @param  count             Pointer to FIFO byte count, NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_sched_poll(adi_adpd7000_device_t *device, adi_adpd7000_sched_t *sched, int64_t host_us, uint16_t *count);
+
+/**
+ * @brief  Tell scheduler bytes were read from FIFO since last observation
+ *         
+ * @param  sched             @see adi_adpd7000_sched_t
+ * @param  size              Bytes read
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_sched_consume(adi_adpd7000_sched_t *sched, uint32_t size);
+
+/**
+ * @brief  Predict host time when a batch of sequences is in FIFO
+ *         
+ * @param  sched             @see adi_adpd7000_sched_t
+ * @param  deadline_us       Pointer to host time to wake up, unit: us
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_sched_get_deadline(adi_adpd7000_sched_t *sched, int64_t *deadline_us);
+
+/**
+ * @brief  Losslessly compress a block of samples, each column coded with its best of
+ *         no, first or second order prediction and an adaptive Rice code.
+ *         Blocks are independent, keep their offsets for random access.
+ *         
+ * @param  values            Pointer to samples, value of column c at row r is values[c * row_stride + r]
+ * @param  row_stride        Rows per column in values
+ * @param  row_num           Row number, 1 ~ ADPD7000_CODEC_MAX_ROWS
+ * @param  column_num        Column number, e.g. from adi_adpd7000_fifo_get_column_sizes
+ * @param  out               Pointer to compressed block
+ * @param  out_size          Size of out in bytes
+ * @param  out_len           Pointer to compressed block size in bytes
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_FULL if out too small, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_codec_encode_block(const uint32_t *values, uint32_t row_stride, uint16_t row_num, uint16_t column_num,
+    uint8_t *out, uint32_t out_size, uint32_t *out_len);
+
+/**
+ * @brief  Get compressed block shape and size without decoding it
+ *         
+ * @param  in                Pointer to compressed block
+ * @param  in_size           Bytes available at in
+ * @param  row_num           Pointer to row number, NULL if not needed
+ * @param  column_num        Pointer to column number, NULL if not needed
+ * @param  block_size        Pointer to compressed block size in bytes, NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_codec_get_block_info(const uint8_t *in, uint32_t in_size, uint16_t *row_num, uint16_t *column_num, uint32_t *block_size);
+
+/**
+ * @brief  Decompress a block of samples
+ *         
+ * @param  in                Pointer to compressed block
+ * @param  in_size           Bytes available at in
+ * @param  values            Pointer to samples, value of column c at row r is values[c * row_stride + r]
+ * @param  row_stride        Rows per column in values, at least block row number
+ * @param  block_size        Pointer to compressed block size in bytes, NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_codec_decode_block(const uint8_t *in, uint32_t in_size, uint32_t *values, uint32_t row_stride, uint32_t *block_size);
+
+/**
+ * @brief  Get shared region size of a broadcast ring
+ *         
+ * @param  elem_size         Element size in bytes, e.g. sizeof(adi_adpd7000_frame_t)
+ * @param  capacity          Element number, power of 2
+ * @param  reader_max        Max readers attached at the same time
+ * @param  size              Pointer to region size in bytes
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_get_size(uint32_t elem_size, uint32_t capacity, uint32_t reader_max, uint32_t *size);
+
+/**
+ * @brief  Format shared region as broadcast ring and open it for publishing. Region is usually
+ *         a shared memory mapping, cache line aligned, created by the caller.
+ *         
+ * @param  bcast             @see adi_adpd7000_bcast_t
+ * @param  mem               Pointer to shared region
+ * @param  size              Region size in bytes, @see adi_adpd7000_bcast_get_size
+ * @param  elem_size         Element size in bytes
+ * @param  capacity          Element number, power of 2
+ * @param  reader_max        Max readers attached at the same time
+ * @param  notify            @see adi_adpd7000_bcast_notify, NULL if not used
+ * @param  user_data         Pointer to user data passed to notify function
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_create(adi_adpd7000_bcast_t *bcast, void *mem, uint32_t size, uint32_t elem_size, uint32_t capacity,
+    uint32_t reader_max, adi_adpd7000_bcast_notify notify, void *user_data);
+
+/**
+ * @brief  Reserve next element in place, publisher only. Element is dropped and counted if the
+ *         slowest reader is a ring behind.
+ *         
+ * @param  bcast             @see adi_adpd7000_bcast_t
+ * @param  elem              Pointer to reserved element, fill it then call adi_adpd7000_bcast_commit
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_FULL if dropped, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_reserve(adi_adpd7000_bcast_t *bcast, void **elem);
+
+/**
+ * @brief  Publish reserved element to all readers and call notify function
+ *         
+ * @param  bcast             @see adi_adpd7000_bcast_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_commit(adi_adpd7000_bcast_t *bcast);
+
+/**
+ * @brief  Copy element into broadcast ring and publish it
+ *         
+ * @param  bcast             @see adi_adpd7000_bcast_t
+ * @param  elem              Pointer to element
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_publish(adi_adpd7000_bcast_t *bcast, const void *elem);
+
+/**
+ * @brief  Get broadcast ring statistics
+ *         
+ * @param  bcast             @see adi_adpd7000_bcast_t
+ * @param  reader_num        Pointer to attached reader number, NULL if not needed
+ * @param  drop_count        Pointer to dropped element number, NULL if not needed
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_get_stats(adi_adpd7000_bcast_t *bcast, uint32_t *reader_num, uint32_t *drop_count);
+
+/**
+ * @brief  Stream frame callback publishing frames, register it with broadcast ring as user_data,
+ *         element size must be sizeof(adi_adpd7000_frame_t)
+ *         
+ * @param  user_data         Pointer to @see adi_adpd7000_bcast_t
+ * @param  frame             Decoded frame
+ */
+void adi_adpd7000_bcast_frame_cb(void *user_data, const adi_adpd7000_frame_t *frame);
+
+/**
+ * @brief  Attach to a broadcast ring, reading starts at the next published element
+ *         
+ * @param  reader            @see adi_adpd7000_bcast_reader_t
+ * @param  mem               Pointer to shared region, mapped in this process
+ * @param  size              Region size in bytes
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_FULL if no free reader slot, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_attach(adi_adpd7000_bcast_reader_t *reader, void *mem, uint32_t size);
+
+/**
+ * @brief  Detach from a broadcast ring, frees the reader slot
+ *         
+ * @param  reader            @see adi_adpd7000_bcast_reader_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_detach(adi_adpd7000_bcast_reader_t *reader);
+
+/**
+ * @brief  Get oldest unread element in place, reader only
+ *         
+ * @param  reader            @see adi_adpd7000_bcast_reader_t
+ * @param  elem              Pointer to oldest element, call adi_adpd7000_bcast_release when done
+ *
+ * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_BUFFER_EMPTY if nothing to read, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_peek(adi_adpd7000_bcast_reader_t *reader, const void **elem);
+
+/**
+ * @brief  Release element got by adi_adpd7000_bcast_peek, reader only
+ *         
+ * @param  reader            @see adi_adpd7000_bcast_reader_t
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_release(adi_adpd7000_bcast_reader_t *reader);
+
+/**
+ * @brief  Get unread element number, reader only
+ *         
+ * @param  reader            @see adi_adpd7000_bcast_reader_t
+ * @param  count             Pointer to unread element number
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_bcast_get_count(adi_adpd7000_bcast_reader_t *reader, uint32_t *count);
+
+/**
+ * @brief  Init aligner
+ *         
+ * @param  align             @see adi_adpd7000_align_t
+ * @param  out_freq          Output frequency, unit: Hz
+ * @param  cb                @see adi_adpd7000_align_cb
+ * @param  user_data         Pointer to user data passed to callback
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_align_init(adi_adpd7000_align_t *align, double out_freq, adi_adpd7000_align_cb cb, void *user_data);
+
+/**
+ * @brief  Add a channel before pushing samples. Sample n of the channel is taken at
+ *         offset_us + n * seq_period_us * decimate / sample_num.
+ *         
+ * @param  align             @see adi_adpd7000_align_t
+ * @param  seq_period_us     Sequence period, 1e6 / timeslot frequency, unit: us
+ * @param  sample_num        Samples per sequence, e.g. ecg_over_sample for ECG, 1 for PPG and BioZ
+ * @param  decimate          Sequences per sample, e.g. PPG decimation factor, 1 if not decimated
+ * @param  offset_us         Time of first sample including timeslot offset, unit: us
+ * @param  channel           Pointer to channel index
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_align_add_channel(adi_adpd7000_align_t *align, double seq_period_us, uint8_t sample_num, uint16_t decimate,
+    double offset_us, uint8_t *channel);
+
+/**
+ * @brief  Push next sample of a channel. Outputs are computed by cubic interpolation as soon
+ *         as the channel has the samples around them, and a frame is passed to the callback
+ *         once all channels have it. Constant memory and work per sample.
+ *         Channels faster than output are not low pass filtered, filter them first if needed.
+ *         If a channel runs ADPD7000_ALIGN_QUEUE outputs ahead of another, the oldest outputs are dropped
+ *         and the late channel resumes at the first output not dropped.
+ *         
+ * @param  align             @see adi_adpd7000_align_t
+ * @param  channel           Channel index
+ * @param  value             Sample value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+int32_t adi_adpd7000_align_push(adi_adpd7000_align_t *align, uint8_t channel, double value);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,790 @@
+/*!
+ * @brief     adi adpd7000 C++ header file, compile time register and bitfield access
+ *
+ * Needs C++17, the FIFO views need C++20 std::span. Bitfield macros of adi_adpd7000_bf_reg.h expand to address and info pair,
+ * so they are template arguments as is: adi_adpd7000::bf<BF_PPG_TIMESLOT_EN_INFO>.
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+#ifndef __ADI_ADPD7000_HPP__
+#define __ADI_ADPD7000_HPP__
+
+/*============= I N C L U D E S ============*/
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <utility>
+#if (__cplusplus >= 202002L) && __has_include(<span>)
+#include <span>
+#define ADPD7000_HAS_SPAN           (1)
+#endif
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_SESSION_MAX_BURST  (64)                        /*!< Max registers coalesced into one block write */
+#define ADPD7000_SESSION_MAX_GAP    (4)                         /*!< Max untouched registers read back to join two runs */
+
+namespace adi_adpd7000 {
+
+/*!
+ * @brief  Tag of register descriptors
+ */
+struct reg_tag {};
+
+/*!
+ * @brief  Tag of bitfield descriptors
+ */
+struct bf_tag {};
+
+/*!
+ * @brief  Register descriptor
+ */
+template <uint32_t Addr>
+struct reg : reg_tag
+{
+    static constexpr uint32_t addr = Addr;                      /*!< Register address */
+};
+
+/*!
+ * @brief  Bitfield descriptor, info byte 0 is start bit, byte 1 is bit count
+ */
+template <uint32_t Addr, uint32_t Info>
+struct bf : bf_tag
+{
+    static constexpr uint32_t addr  = Addr;                     /*!< Register address */
+    static constexpr uint8_t  shift = Info & 0xff;              /*!< Start bit */
+    static constexpr uint8_t  width = (Info >> 8) & 0xff;       /*!< Bit count */
+    static_assert((width > 0) && (shift + width <= 16), "bitfield must lie in one register");
+    static constexpr uint16_t max   = (width == 16) ? 0xffff : ((1u << width) - 1); /*!< Max field value */
+    static constexpr uint16_t mask  = max << shift;             /*!< Field mask in register */
+    using value_type = std::conditional_t<(width <= 8), uint8_t, uint16_t>;
+};
+
+/*!
+ * @brief  PPG timeslot bitfield, Info is the timeslot A bitfield
+ */
+template <uint8_t Slot, uint32_t Addr, uint32_t Info>
+struct ppg_bf : bf<Addr + ADPD7000_TIME_SLOT_SPAN * Slot, Info>
+{
+    static_assert(Slot < ADPD7000_PPG_MAX_SLOT, "PPG timeslot out of range");
+};
+
+/*!
+ * @brief  BioZ timeslot bitfield, Info is the timeslot A bitfield
+ */
+template <uint8_t Slot, uint32_t Addr, uint32_t Info>
+struct bioz_bf : bf<Addr + ADPD7000_BIOZ_SLOT_SPAN * Slot, Info>
+{
+    static_assert(Slot < ADPD7000_BIOZ_MAX_SLOT, "BioZ timeslot out of range");
+};
+
+template <typename T>
+inline constexpr bool is_reg_v = std::is_base_of_v<reg_tag, T>;
+
+template <typename T>
+inline constexpr bool is_bf_v = std::is_base_of_v<bf_tag, T>;
+
+/*============= C O D E ====================*/
+/**
+ * @brief  Read register
+ *
+ * @param  device            Pointer to device structure
+ * @param  value             Register value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+template <typename Reg>
+inline int32_t reg_read(adi_adpd7000_device_t *device, uint16_t &value)
+{
+    static_assert(is_reg_v<Reg>, "register descriptor expected");
+    return adi_adpd7000_hal_reg_read(device, Reg::addr, &value);
+}
+
+/**
+ * @brief  Write register
+ *
+ * @param  device            Pointer to device structure
+ * @param  value             Register value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+template <typename Reg>
+inline int32_t reg_write(adi_adpd7000_device_t *device, uint16_t value)
+{
+    static_assert(is_reg_v<Reg>, "register descriptor expected");
+    return adi_adpd7000_hal_reg_write(device, Reg::addr, value);
+}
+
+/**
+ * @brief  Read bitfield
+ *
+ * @param  device            Pointer to device structure
+ * @param  value             Bitfield value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+template <typename Bf>
+inline int32_t bf_read(adi_adpd7000_device_t *device, typename Bf::value_type &value)
+{
+    static_assert(is_bf_v<Bf>, "bitfield descriptor expected");
+    int32_t  err;
+    uint16_t data;
+
+    err = adi_adpd7000_hal_reg_read(device, Bf::addr, &data);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    value = static_cast<typename Bf::value_type>((data & Bf::mask) >> Bf::shift);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+/**
+ * @brief  Write bitfield, read modify write unless the field is the whole register
+ *
+ * @param  device            Pointer to device structure
+ * @param  value             Bitfield value
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+template <typename Bf>
+inline int32_t bf_write(adi_adpd7000_device_t *device, typename Bf::value_type value)
+{
+    static_assert(is_bf_v<Bf>, "bitfield descriptor expected");
+    int32_t  err;
+    uint16_t data;
+
+    /* folds away when the value type can not exceed the field */
+    if (value > Bf::max)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if constexpr (Bf::mask == 0xffff)
+    {
+        return adi_adpd7000_hal_reg_write(device, Bf::addr, value);
+    }
+    else
+    {
+        err = adi_adpd7000_hal_reg_read(device, Bf::addr, &data);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+        data = static_cast<uint16_t>((data & ~Bf::mask) | (value << Bf::shift));
+        return adi_adpd7000_hal_reg_write(device, Bf::addr, data);
+    }
+}
+
+/**
+ * @brief  Write constant to bitfield, value is range checked at compile time
+ *
+ * @param  device            Pointer to device structure
+ *
+ * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+ */
+template <typename Bf, uint16_t Value>
+inline int32_t bf_write(adi_adpd7000_device_t *device)
+{
+    static_assert(is_bf_v<Bf>, "bitfield descriptor expected");
+    static_assert(Value <= Bf::max, "value does not fit bitfield");
+    return bf_write<Bf>(device, static_cast<typename Bf::value_type>(Value));
+}
+
+/*!
+ * @brief  Configuration session. While it is alive the SDK setters called with its device are recorded in a
+ *         register shadow instead of being written. On scope exit the changed registers are validated and
+ *         written in block writes, or dropped if an exception is unwinding. Changed registers up to
+ *         ADPD7000_SESSION_MAX_GAP apart are joined by reading the untouched ones between into the shadow and
+ *         writing them back unchanged, each block write still goes on the bus in chunks of
+ *         (ADPD7000_SDK_MAX_BUFSIZE - 2) / 2 registers, 7 by default, @see adi_adpd7000_hal_reg_write_block.
+ *         Status, timestamp and data registers and registers with pulse bits (FIFO clear, soft reset, oscillator
+ *         calibration start) bypass the shadow. Such a write first commits the changes recorded before it, so
+ *         they reach the device in call order, and the shadow is read again after it. Not thread safe, the
+ *         device must not be used by other threads meanwhile.
+ */
+class config_session
+{
+public:
+    /**
+     * @brief  Validation of the combined change, called before commit
+     *
+     * @param  session           Session to check, @see config_session::get
+     *
+     * @return API_ADPD7000_ERROR_OK to commit, @see adi_adpd7000_error_e
+     */
+    using validator = std::function<int32_t(const config_session &session)>;
+
+    /**
+     * @brief  Start recording the register writes of device
+     *
+     * @param  device            Pointer to device structure
+     * @param  check             Optional validation of the combined change
+     */
+    explicit config_session(adi_adpd7000_device_t *device, validator check = nullptr)
+        : device(device), saved(*device), check(std::move(check)), exceptions(std::uncaught_exceptions())
+    {
+        device->user_data = this;
+        device->read = &config_session::shadow_read;
+        device->write = &config_session::shadow_write;
+    }
+
+    config_session(const config_session &) = delete;
+    config_session &operator=(const config_session &) = delete;
+
+    ~config_session()
+    {
+        if (std::uncaught_exceptions() > exceptions)
+            rollback();
+        else
+            commit();
+    }
+
+    /**
+     * @brief  Record the result of a setter, a failed setter makes the whole session fail at commit
+     *
+     * @param  err               Setter return value
+     *
+     * @return err
+     */
+    int32_t record(int32_t err)
+    {
+        if ((err != API_ADPD7000_ERROR_OK) && (this->err == API_ADPD7000_ERROR_OK))
+            this->err = err;
+        return err;
+    }
+
+    /**
+     * @brief  Get pending register value
+     *
+     * @param  addr              Register address
+     * @param  value             Pending value
+     *
+     * @return API_ADPD7000_ERROR_OK for success, API_ADPD7000_ERROR_INVALID_PARAM if the register was not touched
+     */
+    int32_t get(uint32_t addr, uint16_t &value) const
+    {
+        auto it = shadow.find(addr);
+
+        if (it == shadow.end())
+            return API_ADPD7000_ERROR_INVALID_PARAM;
+        value = it->second.value;
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    /**
+     * @brief  Stop recording, validate and write changed registers. Registers up to ADPD7000_SESSION_MAX_GAP apart
+     *         go in one block write, on a write error the registers already written are restored. Only the first
+     *         call has effect.
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    int32_t commit()
+    {
+        if (!end())
+            return err;
+        if ((err == API_ADPD7000_ERROR_OK) && check)
+            err = check(*this);
+        if (err == API_ADPD7000_ERROR_OK)
+            err = flush(device);
+        if (err != API_ADPD7000_ERROR_OK)
+            restore(device);
+        shadow.clear();
+        return err;
+    }
+
+    /**
+     * @brief  Stop recording and drop the recorded changes
+     */
+    void rollback()
+    {
+        end();
+        shadow.clear();
+    }
+
+private:
+    struct entry
+    {
+        uint16_t orig;                                          /*!< Device value when first touched */
+        uint16_t value;                                         /*!< Pending value */
+    };
+
+    static bool is_volatile(uint32_t addr)
+    {
+        /* a pulse written 1 then 0 must reach the device, in the shadow it collapses to no change */
+        return (addr <= REG_GLOBAL_STATUS_ADDR) || ((addr >= REG_STAMP_L_ADDR) && (addr <= REG_STAMPDELTA_ADDR)) ||
+               (addr == REG_GPIO_IN_ADDR) || ((addr >= REG_FIFO_DATA_ADDR) && (addr <= REG_DARK2_H_B_ADDR)) ||
+               (addr == REG_OSC32M_CAL_ADDR) || (addr == REG_SYS_CTL_ADDR);
+    }
+
+    bool end()
+    {
+        if (device->user_data != this)
+            return false;
+        *device = saved;
+        return true;
+    }
+
+    /* untouched registers in a short gap between changed ones, read back so both runs go in one block write */
+    int32_t fill(adi_adpd7000_device_t *dev)
+    {
+        uint32_t prev = 0, gap, i;
+        uint16_t data[ADPD7000_SESSION_MAX_GAP];
+        bool     first = true, missing;
+        int32_t  err;
+
+        for (auto it = shadow.begin(); it != shadow.end(); ++it)
+        {
+            if (it->second.value == it->second.orig)
+                continue;
+            gap = it->first - prev - 1;
+            missing = false;
+            for (i = 0; !first && (gap <= ADPD7000_SESSION_MAX_GAP) && (i < gap); i++)
+            {
+                if (is_volatile(prev + 1 + i))
+                    break;
+                missing = missing || (shadow.find(prev + 1 + i) == shadow.end());
+            }
+            if (missing && (i == gap))
+            {
+                err = adi_adpd7000_hal_reg_read_block(dev, prev + 1, data, gap);
+                if (err != API_ADPD7000_ERROR_OK)
+                    return err;
+                /* registers already in the shadow keep their recorded value */
+                for (i = 0; i < gap; i++)
+                    shadow.emplace(prev + 1 + i, entry{ data[i], data[i] });
+            }
+            prev = it->first;
+            first = false;
+        }
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    /* write changed registers, unchanged ones between two changes are written back to keep one block write */
+    int32_t flush(adi_adpd7000_device_t *dev)
+    {
+        auto     it = shadow.begin();
+        uint32_t addr, num, skip;
+        uint16_t data[ADPD7000_SESSION_MAX_BURST];
+        int32_t  err;
+
+        err = fill(dev);
+        while ((err == API_ADPD7000_ERROR_OK) && (it != shadow.end()))
+        {
+            if (it->second.value == it->second.orig)
+            {
+                ++it;
+                continue;
+            }
+            addr = it->first;
+            num = 0;
+            skip = 0;
+            for (; (it != shadow.end()) && (it->first == addr + num + skip) && (num + skip < ADPD7000_SESSION_MAX_BURST); ++it)
+            {
+                if (it->second.value == it->second.orig)
+                {
+                    if (++skip > ADPD7000_SESSION_MAX_GAP)
+                        break;
+                    continue;
+                }
+                for (; skip > 0; skip--)
+                {
+                    data[num] = shadow[addr + num].orig;
+                    num++;
+                }
+                data[num++] = it->second.value;
+            }
+            /* a failed burst may have reached the device in part, restore covers it */
+            written = addr + num;
+            err = adi_adpd7000_hal_reg_write_block(dev, addr, data, num);
+        }
+        return err;
+    }
+
+    /* registers are committed in address order, write back the ones done before the failure */
+    void restore(adi_adpd7000_device_t *dev)
+    {
+        for (auto &e : shadow)
+        {
+            if (e.first >= written)
+                break;
+            if (e.second.value != e.second.orig)
+                adi_adpd7000_hal_reg_write(dev, e.first, e.second.orig);
+        }
+    }
+
+    /* changes recorded before a pass through write reach the device first, the write may reset them */
+    int32_t pass_write(uint8_t *wr_buf, uint32_t len)
+    {
+        int32_t err = API_ADPD7000_ERROR_OK;
+
+        if (this->err == API_ADPD7000_ERROR_OK)
+        {
+            if (check)
+                err = check(*this);
+            if (err == API_ADPD7000_ERROR_OK)
+                err = flush(&saved);
+            if (err != API_ADPD7000_ERROR_OK)
+                restore(&saved);
+        }
+        shadow.clear();
+        written = 0;
+        if (err != API_ADPD7000_ERROR_OK)
+            return record(err);
+        return saved.write(saved.user_data, wr_buf, len);
+    }
+
+    int32_t touch(uint32_t addr, entry *&e)
+    {
+        int32_t err;
+        uint16_t data;
+        auto it = shadow.find(addr);
+
+        if (it == shadow.end())
+        {
+            *device = saved;
+            err = adi_adpd7000_hal_reg_read(device, addr, &data);
+            device->user_data = this;
+            device->read = &config_session::shadow_read;
+            device->write = &config_session::shadow_write;
+            if (err != API_ADPD7000_ERROR_OK)
+                return err;
+            it = shadow.emplace(addr, entry{ data, data }).first;
+        }
+        e = &it->second;
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    static int32_t shadow_read(void *user_data, uint8_t *rd_buf, uint32_t rd_len, uint8_t *wr_buf, uint32_t wr_len)
+    {
+        config_session *self = static_cast<config_session *>(user_data);
+        uint32_t addr = ((wr_buf[0] << 8) | wr_buf[1]) >> 1;
+        entry    *e;
+        int32_t  err;
+
+        if ((wr_len != 2) || (rd_len != 2) || (wr_buf[1] & 1) || is_volatile(addr))
+            return self->saved.read(self->saved.user_data, rd_buf, rd_len, wr_buf, wr_len);
+        err = self->touch(addr, e);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+        rd_buf[0] = (uint8_t)(e->value >> 8);
+        rd_buf[1] = (uint8_t)e->value;
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    static int32_t shadow_write(void *user_data, uint8_t *wr_buf, uint32_t len)
+    {
+        config_session *self = static_cast<config_session *>(user_data);
+        uint32_t addr = ((wr_buf[0] << 8) | wr_buf[1]) >> 1;
+        entry    *e;
+        int32_t  err;
+
+        if ((len != 4) || !(wr_buf[1] & 1) || is_volatile(addr))
+            return self->pass_write(wr_buf, len);
+        err = self->touch(addr, e);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+        e->value = (uint16_t)((wr_buf[2] << 8) | wr_buf[3]);
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    adi_adpd7000_device_t       *device;
+    adi_adpd7000_device_t       saved;
+    validator                   check;
+    int                         exceptions;
+    int32_t                     err = API_ADPD7000_ERROR_OK;
+    uint32_t                    written = 0;
+    std::map<uint32_t, entry>   shadow;
+};
+
+/*!
+ * @brief  Status bytes appended to a fixed layout sequence, or them together
+ */
+enum fifo_status : uint8_t
+{
+    FIFO_STATUS_NONE    = 0,                                    /*!< No status bytes */
+    FIFO_STATUS_SEQ_NUM = 1,                                    /*!< Sequence number */
+    FIFO_STATUS_LEV0    = 2,                                    /*!< PPG level 0 status */
+    FIFO_STATUS_LEV1    = 4,                                    /*!< PPG level 1 status */
+    FIFO_STATUS_LEVX    = 8,                                    /*!< BioZ saturation status */
+};
+
+namespace detail {
+
+template <uint8_t Size>
+inline uint32_t fifo_value(const uint8_t *data)
+{
+    static_assert(Size <= 4, "FIFO value is at most 4 bytes");
+    if constexpr (Size == 0)
+        return 0;
+    else if constexpr (Size == 1)
+        return data[0];
+    else if constexpr (Size == 2)
+        return ((uint32_t)data[0] << 8) | data[1];
+    else if constexpr (Size == 3)
+        return ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2];
+    else
+        return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+template <typename F, size_t... I>
+inline void unroll(F &&f, std::index_sequence<I...>)
+{
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+} /* namespace detail */
+
+/*!
+ * @brief  FIFO sequence decoder for a layout fixed at compile time, every PPG slot has the same channels and
+ *         field sizes. Decoding is unrolled and gives the same frame as adi_adpd7000_fifo_decode_frame.
+ */
+template <uint8_t EcgNum, uint8_t EcgSize, uint8_t PpgSlot, uint8_t PpgChnl, uint8_t SignalSize, uint8_t DarkSize, uint8_t LitSize,
+    uint8_t BiozSlot, uint8_t Status = FIFO_STATUS_NONE>
+struct fixed_decoder
+{
+    static_assert(EcgNum <= ADPD7000_ECG_MAX_OVER_SAMPLE, "too many ECG samples");
+    static_assert((EcgNum == 0) || (EcgSize == 3) || (EcgSize == 4), "ECG size is 3 or 4 bytes");
+    static_assert(PpgSlot <= ADPD7000_PPG_MAX_SLOT, "too many PPG slots");
+    static_assert((PpgSlot == 0) || (PpgChnl == 1) || (PpgChnl == 2), "PPG channel number is 1 or 2");
+    static_assert(BiozSlot <= ADPD7000_BIOZ_MAX_SLOT, "too many BioZ slots");
+
+    static constexpr uint32_t ppg_size    = PpgChnl * (SignalSize + DarkSize + LitSize);
+    static constexpr uint32_t status_size = ((Status & FIFO_STATUS_SEQ_NUM) ? ADPD7000_SEQ_NUM_SIZE : 0) +
+                                            ((Status & FIFO_STATUS_LEV0) ? ADPD7000_STAT_LEV0_SIZE : 0) +
+                                            ((Status & FIFO_STATUS_LEV1) ? ADPD7000_STAT_LEV1_SIZE : 0) +
+                                            ((Status & FIFO_STATUS_LEVX) ? ADPD7000_STAT_LEVX_SIZE : 0);
+    static constexpr uint32_t sequence_size = EcgNum * EcgSize + PpgSlot * ppg_size + BiozSlot * 6 + status_size;
+    static_assert(sequence_size <= ADPD7000_FIFO_SIZE, "sequence does not fit FIFO");
+
+    /**
+     * @brief  Check that the device FIFO configuration is this layout
+     *
+     * @param  fifo              @see adi_adpd7000_fifo_config_t
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    static int32_t check(const adi_adpd7000_fifo_config_t &fifo)
+    {
+        uint8_t i;
+
+        if (((fifo.ecg_slot ? fifo.ecg_over_sample : 0) != EcgNum) || ((EcgNum > 0) && (fifo.ecg_size != EcgSize)) ||
+            (fifo.ppg_slot != PpgSlot) || (fifo.bioz_slot != BiozSlot) ||
+            ((fifo.seq_num_en != 0) != ((Status & FIFO_STATUS_SEQ_NUM) != 0)) ||
+            ((fifo.stat_lev0_en != 0) != ((Status & FIFO_STATUS_LEV0) != 0)) ||
+            ((fifo.stat_lev1_en != 0) != ((Status & FIFO_STATUS_LEV1) != 0)) ||
+            ((fifo.stat_levx_en != 0) != ((Status & FIFO_STATUS_LEVX) != 0)) || (fifo.sequence_size != sequence_size))
+            return API_ADPD7000_ERROR_INVALID_PARAM;
+        for (i = 0; i < PpgSlot; i++)
+        {
+            if ((fifo.ppg_fifo[i].ppg_chl2_en + 1 != PpgChnl) || (fifo.ppg_fifo[i].signal_size != SignalSize) ||
+                (fifo.ppg_fifo[i].dark_size != DarkSize) || (fifo.ppg_fifo[i].lit_size != LitSize))
+                return API_ADPD7000_ERROR_INVALID_PARAM;
+        }
+
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    /**
+     * @brief  Decode one sequence, data must hold sequence_size bytes
+     *
+     * @param  data              FIFO data of one sequence
+     * @param  frame             @see adi_adpd7000_frame_t
+     */
+    static void decode(const uint8_t *data, adi_adpd7000_frame_t &frame)
+    {
+        uint8_t ecg_num = 0;
+
+        detail::unroll([&](auto i) {
+            const uint8_t *p = data + i * EcgSize;
+            if constexpr (EcgSize == 4)
+            {
+                frame.ecg_status[ecg_num] = p[0];
+                frame.ecg_data[ecg_num] = detail::fifo_value<3>(p + 1);
+                /* filler samples are overwritten by the next one instead of skipped by a branch */
+                if constexpr ((PpgSlot != 0) || (BiozSlot != 0))
+                    ecg_num += (p[0] != 0xff);
+                else
+                    ecg_num++;
+            }
+            else
+            {
+                frame.ecg_status[ecg_num] = 0;
+                frame.ecg_data[ecg_num] = detail::fifo_value<3>(p);
+                ecg_num++;
+            }
+        }, std::make_index_sequence<EcgNum>{});
+        frame.ecg_num = ecg_num;
+        data += EcgNum * EcgSize;
+
+        detail::unroll([&](auto i) {
+            detail::unroll([&](auto j) {
+                const uint8_t *p = data + i * ppg_size + j * (SignalSize + DarkSize + LitSize);
+                frame.ppg_signal[i].chnl[j] = detail::fifo_value<SignalSize>(p);
+                frame.ppg_dark[i].chnl[j] = detail::fifo_value<DarkSize>(p + SignalSize);
+                frame.ppg_lit[i].chnl[j] = detail::fifo_value<LitSize>(p + SignalSize + DarkSize);
+            }, std::make_index_sequence<PpgChnl>{});
+        }, std::make_index_sequence<PpgSlot>{});
+        frame.ppg_slot_num = PpgSlot;
+        data += PpgSlot * ppg_size;
+
+        detail::unroll([&](auto i) {
+            frame.bioz[i].real = detail::fifo_value<3>(data + i * 6);
+            frame.bioz[i].imag = detail::fifo_value<3>(data + i * 6 + 3);
+        }, std::make_index_sequence<BiozSlot>{});
+        frame.bioz_num = BiozSlot;
+        data += BiozSlot * 6;
+
+        if constexpr ((Status & FIFO_STATUS_SEQ_NUM) != 0)
+        {
+            frame.status.seq_num = data[0];
+            data += ADPD7000_SEQ_NUM_SIZE;
+        }
+        else
+        {
+            frame.status.seq_num = 0;
+        }
+        if constexpr ((Status & FIFO_STATUS_LEV0) != 0)
+        {
+            frame.status.lev0 = (uint16_t)detail::fifo_value<ADPD7000_STAT_LEV0_SIZE>(data);
+            data += ADPD7000_STAT_LEV0_SIZE;
+        }
+        else
+        {
+            frame.status.lev0 = 0;
+        }
+        if constexpr ((Status & FIFO_STATUS_LEV1) != 0)
+        {
+            frame.status.lev1 = (uint16_t)detail::fifo_value<ADPD7000_STAT_LEV1_SIZE>(data);
+            data += ADPD7000_STAT_LEV1_SIZE;
+        }
+        else
+        {
+            frame.status.lev1 = 0;
+        }
+        frame.status.levx = ((Status & FIFO_STATUS_LEVX) != 0) ? detail::fifo_value<ADPD7000_STAT_LEVX_SIZE>(data) : 0;
+    }
+
+    /**
+     * @brief  Decode the whole sequences of a FIFO buffer
+     *
+     * @param  data              FIFO data
+     * @param  size              Size of FIFO data
+     * @param  frame             Frame array
+     * @param  frame_num         Size of frame array
+     *
+     * @return Number of frames decoded
+     */
+    static uint32_t decode(const uint8_t *data, uint32_t size, adi_adpd7000_frame_t *frame, uint32_t frame_num)
+    {
+        uint32_t n;
+
+        for (n = 0; (n < frame_num) && (size >= sequence_size); n++, size -= sequence_size, data += sequence_size)
+        {
+            decode(data, frame[n]);
+        }
+
+        return n;
+    }
+};
+
+#ifdef ADPD7000_HAS_SPAN
+/*!
+ * @brief  One value of every sequence of a raw FIFO buffer, decoded on access, @see adi_adpd7000_column_view_t
+ */
+class column
+{
+public:
+    column() = default;
+    explicit column(const adi_adpd7000_column_view_t &view) : view(view) {}
+
+    uint32_t operator[](size_t index) const
+    {
+        const uint8_t *p = view.data + (index / view.per_seq) * view.sequence_size + (index % view.per_seq) * view.step;
+        uint32_t data = 0;
+        uint8_t  k;
+
+        for (k = 0; k < view.size; k++)
+        {
+            data = (data << 8) | p[k];
+        }
+        return data;
+    }
+
+    size_t size() const { return view.len; }
+
+    bool empty() const { return view.len == 0; }
+
+private:
+    adi_adpd7000_column_view_t view{};
+};
+
+/*!
+ * @brief  Non owning view over a raw multi-sequence FIFO buffer, @see adi_adpd7000_fifo_view_t. Columns of a
+ *         slot or channel not in the layout are empty.
+ */
+class fifo_view
+{
+public:
+    fifo_view(adi_adpd7000_fifo_config_t &fifo, std::span<const uint8_t> data)
+    {
+        if (adi_adpd7000_fifo_view_init(&view, &fifo, data.data(), (uint32_t)data.size()) != API_ADPD7000_ERROR_OK)
+        {
+            view.data = data.data();
+            view.fifo = &fifo;
+            view.seq_num = 0;
+        }
+    }
+
+    /**
+     * @brief  Number of whole sequences
+     */
+    size_t size() const { return view.seq_num; }
+
+    /**
+     * @brief  Raw bytes of one sequence
+     */
+    std::span<const uint8_t> sequence(size_t index) const
+    {
+        return std::span<const uint8_t>(view.data + index * view.fifo->sequence_size, view.fifo->sequence_size);
+    }
+
+    column ecg() const { return get(adi_adpd7000_fifo_view_ecg); }
+
+    column ecg_status() const { return get(adi_adpd7000_fifo_view_ecg_status); }
+
+    column ppg(uint8_t slot, uint8_t channel, adi_adpd7000_ppg_field_e field) const
+    {
+        adi_adpd7000_column_view_t c;
+        adi_adpd7000_fifo_view_t   v = view;
+
+        return (adi_adpd7000_fifo_view_ppg(&v, slot, channel, field, &c) == API_ADPD7000_ERROR_OK) ? column(c) : column();
+    }
+
+    column bioz(uint8_t slot, bool imag) const
+    {
+        adi_adpd7000_column_view_t c;
+        adi_adpd7000_fifo_view_t   v = view;
+
+        return (adi_adpd7000_fifo_view_bioz(&v, slot, imag, &c) == API_ADPD7000_ERROR_OK) ? column(c) : column();
+    }
+
+private:
+    column get(int32_t (*fn)(adi_adpd7000_fifo_view_t *, adi_adpd7000_column_view_t *)) const
+    {
+        adi_adpd7000_column_view_t c;
+        adi_adpd7000_fifo_view_t   v = view;
+
+        return (fn(&v, &c) == API_ADPD7000_ERROR_OK) ? column(c) : column();
+    }
+
+    adi_adpd7000_fifo_view_t view{};
+};
+#endif
+
+} /* namespace adi_adpd7000 */
+
+#endif  /*__ADI_ADPD7000_HPP__*/
+/*! @} */
@@ -31,6 +31,38 @@
 /*!< max buffer size that sdk is using internally for control port access */
 #define ADPD7000_SDK_MAX_BUFSIZE   16               /*!< buffer size sdk allocates for control port access */
 
+/*!< cache line size, data written by different contexts is padded to it */
+#ifndef ADPD7000_CACHE_LINE_SIZE
+#define ADPD7000_CACHE_LINE_SIZE   64               /*!< cache line size in bytes */
+#endif
+
+/*!< atomic access used by lock-free buffers, default to gcc/clang builtins, override for other compilers */
+#ifndef ADPD7000_ATOMIC_LOAD_ACQUIRE
+#define ADPD7000_ATOMIC_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)      /*!< load, later accesses not moved before it */
+#define ADPD7000_ATOMIC_LOAD_RELAXED(p)     __atomic_load_n((p), __ATOMIC_RELAXED)      /*!< load, no ordering */
+#define ADPD7000_ATOMIC_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE) /*!< store, earlier accesses not moved after it */
+#define ADPD7000_ATOMIC_STORE_RELAXED(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED) /*!< store, no ordering */
+#endif
+#ifndef ADPD7000_ATOMIC_CAS
+#define ADPD7000_ATOMIC_CAS(p, e, v)        __atomic_compare_exchange_n((p), (e), (v), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) /*!< compare and swap, *e updated on failure */
+#define ADPD7000_ATOMIC_FETCH_ADD(p, v)     __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)  /*!< add, return old value */
+#define ADPD7000_ATOMIC_FETCH_SUB(p, v)     __atomic_fetch_sub((p), (v), __ATOMIC_ACQ_REL)  /*!< subtract, return old value */
+#endif
+
+/*!< SSE2 path in sample codec, enabled when compiler targets SSE2 */
+#ifndef ADPD7000_CODEC_SSE2
+#if defined(__SSE2__)
+#define ADPD7000_CODEC_SSE2        1                /*!< use SSE2 */
+#else
+#define ADPD7000_CODEC_SSE2        0                /*!< scalar only */
+#endif
+#endif
+
+/*!< integer only AGC arithmetic for targets without FPU, gain decisions are the same as float */
+#ifndef ADPD7000_AGC_FIXED_POINT
+#define ADPD7000_AGC_FIXED_POINT   0                /*!< 1 - fixed point, 0 - float */
+#endif
+
 #endif /* __ADI_ADPD7000_CONFIG_H__ */
 
 /*! @} */
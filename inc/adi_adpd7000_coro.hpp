@@ -0,0 +1,408 @@
+/*!
+ * @brief     adi adpd7000 C++ coroutine header file, asynchronous register access and FIFO streaming
+ *
+ * Needs C++20. All coroutines of one device run on the event loop thread that calls
+ * async_device::notify and completes the transport transactions, so many devices share one thread.
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+#ifndef __ADI_ADPD7000_CORO_HPP__
+#define __ADI_ADPD7000_CORO_HPP__
+
+/*============= I N C L U D E S ============*/
+#include <coroutine>
+#include <exception>
+#include <span>
+#include <utility>
+#include "adi_adpd7000.hpp"
+
+namespace adi_adpd7000 {
+
+/*============= D E F I N E S ==============*/
+/*!
+ * @brief  Asynchronous SPI transport
+ */
+class async_transport
+{
+public:
+    /**
+     * @brief  Transaction completion, called on the event loop thread
+     *
+     * @param  ctx               Context passed to submit
+     * @param  err               API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    using done_fn = void (*)(void *ctx, int32_t err);
+
+    virtual ~async_transport() = default;
+
+    /**
+     * @brief  Start one transaction, write wr_len bytes then read rd_len bytes. Buffers stay valid until done is
+     *         called, done must not be called from inside submit.
+     *
+     * @param  wr_buf            Bytes to write
+     * @param  wr_len            Number of bytes to write
+     * @param  rd_buf            Buffer for read bytes
+     * @param  rd_len            Number of bytes to read
+     * @param  done              Completion, not called if submit fails
+     * @param  ctx               Context passed to done
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    virtual int32_t submit(const uint8_t *wr_buf, uint32_t wr_len, uint8_t *rd_buf, uint32_t rd_len, done_fn done, void *ctx) = 0;
+};
+
+/*!
+ * @brief  Lazy coroutine returning T, starts when awaited or by start()
+ */
+template <typename T>
+class task
+{
+public:
+    struct promise_type
+    {
+        T value{};                                              /*!< Returned value */
+        std::coroutine_handle<> continuation;                   /*!< Awaiting coroutine, resumed on completion */
+
+        struct final_awaiter
+        {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+            {
+                std::coroutine_handle<> next = h.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        final_awaiter final_suspend() noexcept { return {}; }
+        void return_value(T v) { value = std::move(v); }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    task(task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+    ~task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    /**
+     * @brief  Run a top level task until its first suspension, keep the task object alive until done()
+     */
+    void start()
+    {
+        if (handle && !handle.done())
+            handle.resume();
+    }
+
+    bool done() const { return !handle || handle.done(); }
+
+    T &result() { return handle.promise().value; }
+
+    bool await_ready() const noexcept { return done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() { return std::move(handle.promise().value); }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/*!
+ * @brief  Frames decoded by one FIFO drain
+ */
+struct frame_batch
+{
+    int32_t err;                                                /*!< API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e */
+    uint8_t oflow;                                              /*!< 1 - FIFO overflowed before drain */
+    uint8_t uflow;                                              /*!< 1 - FIFO underflowed before drain */
+    uint32_t lost;                                              /*!< Cut sequences discarded to realign */
+    std::span<const adi_adpd7000_frame_t> frames;               /*!< Decoded frames, oldest first */
+};
+
+/*!
+ * @brief  Device driven by coroutines over an asynchronous transport, one coroutine awaits a device at a time
+ */
+class async_device
+{
+public:
+    /**
+     * @brief  Init device, FIFO configuration is read with adi_adpd7000_device_get_fifo_config beforehand
+     *
+     * @param  transport         @see async_transport
+     * @param  fifo              @see adi_adpd7000_fifo_config_t
+     */
+    async_device(async_transport &transport, const adi_adpd7000_fifo_config_t &fifo) : transport(transport), fifo(fifo) {}
+
+    /**
+     * @brief  FIFO threshold interrupt, call it from the event loop on the interrupt GPIO edge
+     */
+    void notify()
+    {
+        std::coroutine_handle<> h = std::exchange(waiter, {});
+
+        if (h)
+            h.resume();
+        else
+            pending = true;
+    }
+
+    /**
+     * @brief  Read register
+     *
+     * @param  addr              Register address
+     * @param  value             Register value
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    task<int32_t> reg_read(uint32_t addr, uint16_t &value)
+    {
+        uint8_t wr_buf[2] = { (uint8_t)((addr << 1) >> 8), (uint8_t)(addr << 1) };
+        uint8_t rd_buf[2];
+        int32_t err = co_await transfer{ transport, wr_buf, 2, rd_buf, 2 };
+
+        if (err == API_ADPD7000_ERROR_OK)
+            value = (uint16_t)((rd_buf[0] << 8) | rd_buf[1]);
+        co_return err;
+    }
+
+    /**
+     * @brief  Write register
+     *
+     * @param  addr              Register address
+     * @param  value             Register value
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    task<int32_t> reg_write(uint32_t addr, uint16_t value)
+    {
+        uint8_t wr_buf[4] = { (uint8_t)(((addr << 1) + 1) >> 8), (uint8_t)((addr << 1) + 1), (uint8_t)(value >> 8), (uint8_t)value };
+
+        co_return co_await transfer{ transport, wr_buf, 4, nullptr, 0 };
+    }
+
+    /**
+     * @brief  Read bitfield, @see bf
+     *
+     * @param  value             Bitfield value
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    template <typename Bf>
+    task<int32_t> bf_read(typename Bf::value_type &value)
+    {
+        static_assert(is_bf_v<Bf>, "bitfield descriptor expected");
+        uint16_t data = 0;
+        int32_t  err = co_await reg_read(Bf::addr, data);
+
+        value = static_cast<typename Bf::value_type>((data & Bf::mask) >> Bf::shift);
+        co_return err;
+    }
+
+    /**
+     * @brief  Write bitfield, read modify write unless the field is the whole register, @see bf
+     *
+     * @param  value             Bitfield value
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    template <typename Bf>
+    task<int32_t> bf_write(typename Bf::value_type value)
+    {
+        static_assert(is_bf_v<Bf>, "bitfield descriptor expected");
+        uint16_t data = 0;
+        int32_t  err;
+
+        if (value > Bf::max)
+            co_return API_ADPD7000_ERROR_INVALID_PARAM;
+        if constexpr (Bf::mask != 0xffff)
+        {
+            err = co_await reg_read(Bf::addr, data);
+            if (err != API_ADPD7000_ERROR_OK)
+                co_return err;
+        }
+        data = static_cast<uint16_t>((data & ~Bf::mask) | (value << Bf::shift));
+        co_return co_await reg_write(Bf::addr, data);
+    }
+
+    /**
+     * @brief  Set timeslot frequency, @see adi_adpd7000_device_set_slot_freq
+     *
+     * @param  sys_clk           System clock, unit: Hz
+     * @param  freq              Timeslot frequency, unit: Hz
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    task<int32_t> set_slot_freq(uint32_t sys_clk, uint32_t freq)
+    {
+        uint32_t data;
+        int32_t  err;
+
+        if ((freq == 0) || (sys_clk / freq > 0x7fffff))
+            co_return API_ADPD7000_ERROR_INVALID_PARAM;
+        data = sys_clk / freq;
+        err = co_await bf_write<bf<BF_TIMESLOT_PERIOD_L_INFO>>((uint16_t)(data & 0xffff));
+        if (err != API_ADPD7000_ERROR_OK)
+            co_return err;
+        co_return co_await bf_write<bf<BF_TIMESLOT_PERIOD_H_INFO>>((uint8_t)((data >> 16) & 0x7f));
+    }
+
+    /**
+     * @brief  Set FIFO threshold, the interrupt fires once byte count exceeds it, @see adi_adpd7000_device_set_fifo_threshold
+     *
+     * @param  threshold         FIFO threshold, unit: byte
+     *
+     * @return API_ADPD7000_ERROR_OK for success, @see adi_adpd7000_error_e
+     */
+    task<int32_t> set_fifo_threshold(uint16_t threshold)
+    {
+        if (threshold > 0x1ff)
+            co_return API_ADPD7000_ERROR_INVALID_PARAM;
+        co_return co_await bf_write<bf<BF_FIFO_TH_INFO>>(threshold);
+    }
+
+    /**
+     * @brief  Wait for the FIFO threshold interrupt, then drain whole sequences and decode them.
+     *         A sequence cut by underflow or overflow is discarded and counted in frame_batch::lost,
+     *         same plan as adi_adpd7000_fifo_drain, @see adi_adpd7000_fifo_plan_drain
+     *
+     * @param  frames            Frame storage, at most frames.size() sequences are drained
+     *
+     * @return @see frame_batch, frames points into the storage
+     */
+    task<frame_batch> next_frames(std::span<adi_adpd7000_frame_t> frames)
+    {
+        frame_batch batch{ API_ADPD7000_ERROR_OK, 0, 0, 0, {} };
+        uint16_t status = 0, max_seq;
+        uint32_t i;
+        adi_adpd7000_fifo_plan_t plan;
+        uint8_t  wr_buf[2] = { (uint8_t)((REG_FIFO_DATA_ADDR << 1) >> 8), (uint8_t)(REG_FIFO_DATA_ADDR << 1) };
+
+        if ((fifo.sequence_size == 0) || (fifo.sequence_size > ADPD7000_FIFO_SIZE))
+        {
+            batch.err = API_ADPD7000_ERROR_INVALID_PARAM;
+            co_return batch;
+        }
+        co_await interrupt{ *this };
+
+        batch.err = co_await reg_read(REG_FIFO_STATUS_ADDR, status);
+        if (batch.err != API_ADPD7000_ERROR_OK)
+            co_return batch;
+        batch.oflow = (status & bf<BF_INT_FIFO_OFLOW_INFO>::mask) ? 1 : 0;
+        batch.uflow = (status & bf<BF_INT_FIFO_UFLOW_INFO>::mask) ? 1 : 0;
+        max_seq = ADPD7000_FIFO_SIZE / fifo.sequence_size;
+        if (max_seq > frames.size())
+        {
+            max_seq = (uint16_t)frames.size();
+        }
+        batch.err = adi_adpd7000_fifo_plan_drain(&fifo, &track, status, max_seq, &plan);
+        if (batch.err != API_ADPD7000_ERROR_OK)
+            co_return batch;
+
+        if (plan.head_discard > 0)
+        {
+            batch.err = co_await transfer{ transport, wr_buf, 2, buf, plan.head_discard };
+            if (batch.err != API_ADPD7000_ERROR_OK)
+                co_return batch;
+        }
+        if (plan.seq_count > 0)
+        {
+            batch.err = co_await transfer{ transport, wr_buf, 2, buf, plan.seq_count * fifo.sequence_size };
+            if (batch.err != API_ADPD7000_ERROR_OK)
+                co_return batch;
+        }
+        for (i = 0; i < plan.seq_count; i++)
+        {
+            adi_adpd7000_fifo_decode_frame(&fifo, buf + i * fifo.sequence_size, &frames[i]);
+        }
+        /* frames are decoded, buf is free for the discarded tail */
+        if (plan.tail_discard > 0)
+        {
+            batch.err = co_await transfer{ transport, wr_buf, 2, buf, plan.tail_discard };
+            if (batch.err != API_ADPD7000_ERROR_OK)
+                co_return batch;
+        }
+        batch.lost = plan.lost;
+
+        /* status bits are write 1 to clear, clear threshold and the flags the plan is done with */
+        batch.err = co_await reg_write(REG_FIFO_STATUS_ADDR, plan.clear | bf<BF_INT_FIFO_TH_INFO>::mask);
+        if (batch.err != API_ADPD7000_ERROR_OK)
+            co_return batch;
+
+        batch.frames = frames.first(plan.seq_count);
+        co_return batch;
+    }
+
+private:
+    struct transfer
+    {
+        async_transport         &transport;
+        const uint8_t           *wr_buf;
+        uint32_t                wr_len;
+        uint8_t                 *rd_buf;
+        uint32_t                rd_len;
+        int32_t                 err = API_ADPD7000_ERROR_OK;
+        std::coroutine_handle<> handle;
+
+        transfer(async_transport &transport, const uint8_t *wr_buf, uint32_t wr_len, uint8_t *rd_buf, uint32_t rd_len)
+            : transport(transport), wr_buf(wr_buf), wr_len(wr_len), rd_buf(rd_buf), rd_len(rd_len) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            handle = h;
+            err = transport.submit(wr_buf, wr_len, rd_buf, rd_len, &transfer::done, this);
+            /* not submitted, resume at once with the error */
+            return err == API_ADPD7000_ERROR_OK;
+        }
+
+        int32_t await_resume() const noexcept { return err; }
+
+        static void done(void *ctx, int32_t err)
+        {
+            transfer *self = static_cast<transfer *>(ctx);
+
+            self->err = err;
+            self->handle.resume();
+        }
+    };
+
+    struct interrupt
+    {
+        async_device &device;
+
+        bool await_ready() const noexcept { return std::exchange(device.pending, false); }
+        void await_suspend(std::coroutine_handle<> h) noexcept { device.waiter = h; }
+        void await_resume() const noexcept {}
+    };
+
+    async_transport          &transport;
+    adi_adpd7000_fifo_config_t fifo;
+    adi_adpd7000_fifo_seq_track_t track{};
+    bool                     pending = false;
+    std::coroutine_handle<>  waiter;
+    uint8_t                  buf[ADPD7000_FIFO_SIZE];
+};
+
+} /* namespace adi_adpd7000 */
+
+#endif  /*__ADI_ADPD7000_CORO_HPP__*/
+/*! @} */
@@ -0,0 +1,529 @@
+/*!
+ * @brief     AGC Engine APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#if !ADPD7000_AGC_FIXED_POINT
+#include "math.h"
+#endif
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_AGC_BURST_REG_NUM      (REG_LED_POW12_A_ADDR - REG_AFE_TRIM1_A_ADDR + 1) /*!< TIA gain to LED current registers of a slot */
+#define ADPD7000_AGC_BOUNDARY_POLL      (16)                    /*!< FIFO count reads waiting for a sequence boundary */
+#define ADPD7000_AGC_Q                  (23)                    /*!< Fractional bits of fixed point LED current, exact for float 1 ~ 128 */
+#define ADPD7000_AGC_Q_SAT              (128UL << ADPD7000_AGC_Q) /*!< Fixed point LED current of 128 and above */
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+#if !ADPD7000_AGC_FIXED_POINT
+static void adi_adpd7000_agc_step(adi_adpd7000_agc_t *agc, uint8_t slot)
+{
+    float step;
+    float ppg_data_avg, ppg_chnl_current;
+    int32_t diff;
+    adi_adpd7000_ppg_agc_run_t *run = &agc->slot[slot].run;
+
+    ppg_data_avg = run->ppg_data_sum / agc->cfg.ppg_average_sample_number;
+    ppg_data_avg ++;
+    ppg_chnl_current = (float)(run->led_current * run->ppg_full_scale * 0.5 / ppg_data_avg);
+    if (ppg_chnl_current > 127)
+    {
+        if (run->tia_gain > 0)
+        {
+            run->tia_gain = run->tia_gain - 1;
+            ppg_chnl_current = run->led_current;
+        }
+        else
+        {
+            ppg_chnl_current = run->led_current + 0x10;
+            ppg_chnl_current = (ppg_chnl_current > 127) ? 127 : ppg_chnl_current;
+        }
+    }
+    else if (ppg_chnl_current < 1)
+    {
+        if (run->tia_gain < 5)
+        {
+            run->tia_gain = run->tia_gain + 1;
+            ppg_chnl_current = run->led_current;
+        }
+        else
+        {
+            ppg_chnl_current = (run->led_current > 0x11) ? (run->led_current - 0x10) : 1;
+        }
+    }
+
+    if (agc->cfg.power_first_en == 0)           /* low tia gain */
+    {
+        diff = run->led_current - (uint8_t)ppg_chnl_current;
+        if ((diff > 1) || (diff < -1))
+        {
+            run->led_current = (uint8_t)ppg_chnl_current;
+        }
+        else
+        {
+            if (agc->cfg.slot[slot].agc_type == 1)
+            {
+                run->agc_done = 1;
+            }
+        }
+
+        if ((run->led_current < 0x20) && (run->tia_gain < 5))
+        {
+            run->led_current = run->led_current * 2;
+            run->tia_gain = run->tia_gain + 1;
+        }
+    }
+    else                                        /* low LED current */
+    {
+        step = fabs(ppg_chnl_current - run->led_current) / 4;
+        if (step < 1)
+        {
+            step = 1;
+        }
+        if (run->led_current > ((uint8_t)ppg_chnl_current + 1))
+        {
+            run->led_current -= (uint8_t)step;
+        }
+        else if (run->led_current < ((uint8_t)ppg_chnl_current - 1))
+        {
+            run->led_current += (uint8_t)step;
+        }
+        if ((run->led_current > 0x10) && (run->tia_gain > 2))
+        {
+            run->led_current = run->led_current / 2;
+            run->tia_gain = run->tia_gain - 1;
+        }
+    }
+}
+#else
+/* round to nearest even at 24 significant bits, as conversion to float */
+static uint64_t adi_adpd7000_agc_round_float(uint64_t x)
+{
+    uint8_t  s = 0;
+    uint64_t rem, half;
+
+    while ((x >> s) >= (1ULL << 24))
+    {
+        s++;
+    }
+    if (s == 0)
+    {
+        return x;
+    }
+    rem = x & ((1ULL << s) - 1);
+    half = 1ULL << (s - 1);
+    x >>= s;
+    if ((rem > half) || ((rem == half) && (x & 1)))
+    {
+        x++;
+    }
+
+    return x << s;
+}
+
+/* num / den rounded to double then to float, in Q format, ADPD7000_AGC_Q_SAT if 128 and above */
+static uint32_t adi_adpd7000_agc_quotient(uint32_t num, uint64_t den)
+{
+    int16_t  e = 0;
+    uint8_t  guard;
+    uint64_t m, r;
+
+    if (num == 0)
+    {
+        return 0;
+    }
+    m = num / den;
+    r = num % den;
+    /* 53 bits and a guard bit, value is m * 2^e */
+    while (m < (1ULL << 53))
+    {
+        r <<= 1;
+        m <<= 1;
+        if (r >= den)
+        {
+            m |= 1;
+            r -= den;
+        }
+        e--;
+    }
+    guard = m & 1;
+    m >>= 1;
+    e++;
+    if (guard && ((r != 0) || (m & 1)))
+    {
+        m++;
+    }
+    m = adi_adpd7000_agc_round_float(m);
+
+    /* m is 2^52 at least */
+    if (e + ADPD7000_AGC_Q >= 0)
+    {
+        return ADPD7000_AGC_Q_SAT;
+    }
+    if (e + ADPD7000_AGC_Q <= -64)
+    {
+        return 0;
+    }
+    m >>= -(e + ADPD7000_AGC_Q);
+
+    return (m >= ADPD7000_AGC_Q_SAT) ? ADPD7000_AGC_Q_SAT : (uint32_t)m;
+}
+
+static void adi_adpd7000_agc_step(adi_adpd7000_agc_t *agc, uint8_t slot)
+{
+    int32_t  diff;
+    uint8_t  step, target;
+    uint32_t ppg_chnl_current;                  /* Q format */
+    uint64_t ppg_data_avg, mag;
+    adi_adpd7000_ppg_agc_run_t *run = &agc->slot[slot].run;
+
+    ppg_data_avg = adi_adpd7000_agc_round_float(run->ppg_data_sum / agc->cfg.ppg_average_sample_number);
+    ppg_data_avg = adi_adpd7000_agc_round_float(ppg_data_avg + 1);
+    ppg_chnl_current = adi_adpd7000_agc_quotient((uint32_t)(run->led_current * run->ppg_full_scale), 2 * ppg_data_avg);
+    if (ppg_chnl_current > (127UL << ADPD7000_AGC_Q))
+    {
+        if (run->tia_gain > 0)
+        {
+            run->tia_gain = run->tia_gain - 1;
+            ppg_chnl_current = (uint32_t)run->led_current << ADPD7000_AGC_Q;
+        }
+        else
+        {
+            ppg_chnl_current = (uint32_t)(run->led_current + 0x10) << ADPD7000_AGC_Q;
+            ppg_chnl_current = (ppg_chnl_current > (127UL << ADPD7000_AGC_Q)) ? (127UL << ADPD7000_AGC_Q) : ppg_chnl_current;
+        }
+    }
+    else if (ppg_chnl_current < (1UL << ADPD7000_AGC_Q))
+    {
+        if (run->tia_gain < 5)
+        {
+            run->tia_gain = run->tia_gain + 1;
+            ppg_chnl_current = (uint32_t)run->led_current << ADPD7000_AGC_Q;
+        }
+        else
+        {
+            ppg_chnl_current = (uint32_t)((run->led_current > 0x11) ? (run->led_current - 0x10) : 1) << ADPD7000_AGC_Q;
+        }
+    }
+    target = (uint8_t)(ppg_chnl_current >> ADPD7000_AGC_Q);
+
+    if (agc->cfg.power_first_en == 0)           /* low tia gain */
+    {
+        diff = run->led_current - target;
+        if ((diff > 1) || (diff < -1))
+        {
+            run->led_current = target;
+        }
+        else
+        {
+            if (agc->cfg.slot[slot].agc_type == 1)
+            {
+                run->agc_done = 1;
+            }
+        }
+
+        if ((run->led_current < 0x20) && (run->tia_gain < 5))
+        {
+            run->led_current = run->led_current * 2;
+            run->tia_gain = run->tia_gain + 1;
+        }
+    }
+    else                                        /* low LED current */
+    {
+        /* float difference is rounded to 24 significant bits */
+        diff = (int32_t)ppg_chnl_current - ((int32_t)run->led_current << ADPD7000_AGC_Q);
+        mag = adi_adpd7000_agc_round_float((diff < 0) ? -(int64_t)diff : diff);
+        step = (mag < (4ULL << ADPD7000_AGC_Q)) ? 1 : (uint8_t)(mag >> (ADPD7000_AGC_Q + 2));
+        if (run->led_current > (target + 1))
+        {
+            run->led_current -= step;
+        }
+        else if (run->led_current < (target - 1))
+        {
+            run->led_current += step;
+        }
+        if ((run->led_current > 0x10) && (run->tia_gain > 2))
+        {
+            run->led_current = run->led_current / 2;
+            run->tia_gain = run->tia_gain - 1;
+        }
+    }
+}
+#endif
+
+static void adi_adpd7000_agc_set_field(uint16_t *reg, uint32_t base, uint32_t reg_addr, uint32_t bf_info, uint16_t bf_val)
+{
+    uint8_t  bit_start = bf_info;
+    uint16_t reg_mask = (1 << (uint8_t)(bf_info >> 8)) - 1;
+
+    reg[reg_addr - base] &= ~(reg_mask << bit_start);
+    reg[reg_addr - base] |= (bf_val & reg_mask) << bit_start;
+}
+
+static int32_t adi_adpd7000_agc_write_slot(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc, uint8_t slot)
+{
+    int32_t  err;
+    uint8_t  tia_chnl = agc->cfg.slot[slot].tia_chnl;
+    uint32_t base = ADPD7000_TIME_SLOT_SPAN * slot + REG_AFE_TRIM1_A_ADDR;
+    uint16_t reg[ADPD7000_AGC_BURST_REG_NUM];
+
+    err = adi_adpd7000_hal_reg_read_block(device, base, reg, ADPD7000_AGC_BURST_REG_NUM);
+    ADPD7000_ERROR_RETURN(err);
+    if (tia_chnl < 2)
+    {
+        adi_adpd7000_agc_set_field(reg, base, ADPD7000_TIME_SLOT_SPAN * slot + BF_TIA_GAIN_CH1_A_INFO + tia_chnl * 3, agc->slot[slot].run.tia_gain);
+    }
+    else
+    {
+        adi_adpd7000_agc_set_field(reg, base, ADPD7000_TIME_SLOT_SPAN * slot + BF_TIA_GAIN_CH3_A_INFO + (tia_chnl - 2) * 3, agc->slot[slot].run.tia_gain);
+    }
+    adi_adpd7000_agc_set_field(reg, base, ADPD7000_TIME_SLOT_SPAN * slot + BF_LED_CURRENT1_A_INFO + 8 * agc->cfg.slot[slot].led_chnl,
+        agc->slot[slot].run.led_current);
+
+    /* registers between are written back unchanged, gain and current change together */
+    return adi_adpd7000_hal_reg_write_block(device, base, reg, ADPD7000_AGC_BURST_REG_NUM);
+}
+
+static int32_t adi_adpd7000_agc_restart(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc, uint16_t update)
+{
+    int32_t err;
+    uint8_t i;
+
+    err = adi_adpd7000_device_enable_slot_operation_mode_go(device, false);
+    ADPD7000_ERROR_RETURN(err);
+    for (i = 0; i < agc->slot_num; i++)
+    {
+        if (update & (1 << i))
+        {
+            err = adi_adpd7000_ppg_tia_set_gain_res(device, i, agc->cfg.slot[i].tia_chnl, agc->slot[i].run.tia_gain);
+            ADPD7000_ERROR_RETURN(err);
+            err = adi_adpd7000_ppg_led_set_current(device, i, agc->cfg.slot[i].led_chnl, agc->slot[i].run.led_current);
+            ADPD7000_ERROR_RETURN(err);
+        }
+    }
+    err = adi_adpd7000_device_clr_fifo(device);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_device_enable_slot_operation_mode_go(device, true);
+    ADPD7000_ERROR_RETURN(err);
+
+    /* sequencer restarted, subsample phase restarts with it, next sequence is at the new gain */
+    for (i = 0; i < agc->slot_num; i++)
+    {
+        agc->slot[i].phase = 0;
+        if (update & (1 << i))
+        {
+            agc->slot[i].settle = 0;
+        }
+    }
+    agc->marking |= update;
+    agc->update_count++;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_agc_init(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_agc_cfg_t *ppg_cfg)
+{
+    int32_t  err;
+    uint8_t  i;
+    uint16_t data;
+    adi_adpd7000_agc_slot_t *slot;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(agc);
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_NULL_POINTER_RETURN(ppg_cfg);
+    ADPD7000_INVALID_PARAM_RETURN(ppg_cfg->ppg_average_sample_number == 0);
+    ADPD7000_INVALID_PARAM_RETURN(fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT);
+
+    agc->cfg = *ppg_cfg;
+    agc->update_mode = API_ADPD7000_AGC_UPDATE_RESTART;
+    agc->slot_num = fifo->ppg_slot;
+    agc->sequence_size = fifo->sequence_size;
+    agc->update_count = 0;
+    agc->pending = 0;
+    agc->marking = 0;
+    agc->new_gain = 0;
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        slot = &agc->slot[i];
+        /* FIFO carries channel 1 only, or channel 1 and 2 */
+        slot->chnl = fifo->ppg_fifo[i].ppg_chl2_en ? ppg_cfg->slot[i].tia_chnl : 0;
+        ADPD7000_INVALID_PARAM_RETURN(ppg_cfg->slot[i].agc_en && ((slot->chnl > 1) || (ppg_cfg->slot[i].led_chnl > 1)));
+        slot->sample_count = 0;
+        slot->settle = 0;
+        slot->phase = 0;
+        slot->run.ppg_data_sum = 0;
+        slot->run.agc_done = 0;
+
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_NUM_INT_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        slot->run.ppg_full_scale = 16383 * data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_NUM_REPEAT_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        slot->run.ppg_full_scale = slot->run.ppg_full_scale * data;
+
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_TIA_GAIN_CH1_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        slot->run.tia_gain = (uint8_t)data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_LED_CURRENT1_A_INFO + 8 * ppg_cfg->slot[i].led_chnl, &data);
+        ADPD7000_ERROR_RETURN(err);
+        slot->run.led_current = (uint8_t)data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_SUBSAMPLE_RATIO_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        slot->decimate = (data > 1) ? (uint8_t)data : 1;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_agc_process(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc, const adi_adpd7000_ppg_slot_data_t *signal_data)
+{
+    uint8_t  i, old;
+    uint16_t update = 0;
+    adi_adpd7000_agc_slot_t *slot;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(agc);
+    ADPD7000_NULL_POINTER_RETURN(signal_data);
+
+    agc->new_gain = 0;
+    for (i = 0; i < agc->slot_num; i++)
+    {
+        slot = &agc->slot[i];
+        /* a slot done in the step that changed its gain still reports the first sample at it */
+        if ((agc->cfg.slot[i].agc_en == 0) || ((slot->run.agc_done == 1) && !((agc->pending | agc->marking) & (1 << i))))
+        {
+            continue;
+        }
+        /* sequence taken before the gain decided was written */
+        old = (agc->pending & (1 << i)) ? 1 : 0;
+        if (slot->settle > 0)
+        {
+            slot->settle--;
+            old = 1;
+        }
+        /* decimated slot holds its last sample in the sequences between */
+        if (++slot->phase < slot->decimate)
+        {
+            continue;
+        }
+        slot->phase = 0;
+        if (old)
+        {
+            continue;
+        }
+        if (agc->marking & (1 << i))
+        {
+            agc->marking &= ~(1 << i);
+            agc->new_gain |= 1 << i;
+        }
+        if (slot->run.agc_done == 1)
+        {
+            continue;
+        }
+
+        slot->sample_count++;
+        if (slot->sample_count <= agc->cfg.ppg_skip_sample_number)
+        {
+            continue;
+        }
+        slot->run.ppg_data_sum += signal_data[i].chnl[slot->chnl];
+        if (slot->sample_count < (agc->cfg.ppg_skip_sample_number + agc->cfg.ppg_average_sample_number))
+        {
+            continue;
+        }
+
+        adi_adpd7000_agc_step(agc, i);
+        slot->sample_count = 0;
+        slot->run.ppg_data_sum = 0;
+        update |= 1 << i;
+    }
+    if (update == 0)
+    {
+        return API_ADPD7000_ERROR_OK;
+    }
+    if (agc->update_mode == API_ADPD7000_AGC_UPDATE_BURST)
+    {
+        agc->pending |= update;
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    return adi_adpd7000_agc_restart(device, agc, update);
+}
+
+int32_t adi_adpd7000_agc_set_update_mode(adi_adpd7000_agc_t *agc, adi_adpd7000_agc_update_e mode)
+{
+    if (agc == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (mode > API_ADPD7000_AGC_UPDATE_BURST)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    agc->update_mode = mode;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_agc_apply(adi_adpd7000_device_t *device, adi_adpd7000_agc_t *agc)
+{
+    int32_t  err;
+    uint8_t  i, poll;
+    uint16_t count;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(agc);
+    ADPD7000_INVALID_PARAM_RETURN(agc->sequence_size == 0);
+
+    if (agc->pending == 0)
+    {
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    /* a sequence being written to FIFO would mix old and new gain */
+    for (poll = 0; poll < ADPD7000_AGC_BOUNDARY_POLL; poll++)
+    {
+        err = adi_adpd7000_device_get_fifo_count(device, &count);
+        ADPD7000_ERROR_RETURN(err);
+        if ((count % agc->sequence_size) == 0)
+        {
+            break;
+        }
+    }
+    /* no boundary seen, keep gains pending for the next call rather than risk a mixed sequence */
+    if (poll == ADPD7000_AGC_BOUNDARY_POLL)
+    {
+        ADPD7000_LOG_WARN("no FIFO sequence boundary found, AGC update deferred");
+        return API_ADPD7000_ERROR_TIMEOUT;
+    }
+    for (i = 0; i < agc->slot_num; i++)
+    {
+        if (agc->pending & (1 << i))
+        {
+            err = adi_adpd7000_agc_write_slot(device, agc, i);
+            ADPD7000_ERROR_RETURN(err);
+        }
+    }
+    /* sequences in FIFO, and the one being produced during the write, may be at the old gain */
+    err = adi_adpd7000_device_get_fifo_count(device, &count);
+    ADPD7000_ERROR_RETURN(err);
+    for (i = 0; i < agc->slot_num; i++)
+    {
+        if (agc->pending & (1 << i))
+        {
+            agc->slot[i].settle = count / agc->sequence_size + 1;
+        }
+    }
+    agc->marking |= agc->pending;
+    agc->pending = 0;
+    agc->update_count++;
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -0,0 +1,156 @@
+/*!
+ * @brief     Multi-rate Alignment APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <math.h>
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+/* cubic Lagrange through samples n - 1, n, n + 1, n + 2 at fraction x after sample n */
+static double adi_adpd7000_align_cubic(const double *hist, uint64_t n, double x)
+{
+    double xm1 = x - 1, xm2 = x - 2, xp1 = x + 1;
+
+    return - hist[(n - 1) & 3] * x * xm1 * xm2 / 6
+           + hist[n & 3] * xp1 * xm1 * xm2 / 2
+           - hist[(n + 1) & 3] * xp1 * x * xm2 / 2
+           + hist[(n + 2) & 3] * xp1 * x * xm1 / 6;
+}
+
+/* channels behind the emitted outputs skip to them, the outputs skipped are already counted as dropped */
+static void adi_adpd7000_align_skip(adi_adpd7000_align_t *align)
+{
+    uint8_t i;
+
+    for (i = 0; i < align->channel_num; i++)
+    {
+        if (align->channel[i].next_out < align->emitted)
+        {
+            align->channel[i].next_out = align->emitted;
+        }
+    }
+}
+
+static void adi_adpd7000_align_emit(adi_adpd7000_align_t *align)
+{
+    uint8_t  i;
+    uint64_t ready = align->channel[0].next_out;
+
+    for (i = 1; i < align->channel_num; i++)
+    {
+        if (align->channel[i].next_out < ready)
+        {
+            ready = align->channel[i].next_out;
+        }
+    }
+    while (align->emitted < ready)
+    {
+        for (i = 0; i < align->channel_num; i++)
+        {
+            align->values[i] = align->channel[i].out[align->emitted & (ADPD7000_ALIGN_QUEUE - 1)];
+        }
+        if (align->cb != NULL)
+        {
+            align->cb(align->user_data, align->start + align->emitted * align->out_period, align->values, align->channel_num);
+        }
+        align->emitted++;
+    }
+}
+
+int32_t adi_adpd7000_align_init(adi_adpd7000_align_t *align, double out_freq, adi_adpd7000_align_cb cb, void *user_data)
+{
+    if (align == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (out_freq <= 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    memset(align, 0, sizeof(adi_adpd7000_align_t));
+    align->out_period = 1000000.0 / out_freq;
+    align->cb = cb;
+    align->user_data = user_data;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_align_add_channel(adi_adpd7000_align_t *align, double seq_period_us, uint8_t sample_num, uint16_t decimate,
+    double offset_us, uint8_t *channel)
+{
+    uint8_t i;
+    adi_adpd7000_align_channel_t *ch;
+
+    if ((align == NULL) || (channel == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((seq_period_us <= 0) || (sample_num == 0) || (decimate == 0) || (align->channel_num >= ADPD7000_ALIGN_MAX_CHANNEL))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    for (i = 0; i < align->channel_num; i++)
+    {
+        if (align->channel[i].count > 0)
+            return API_ADPD7000_ERROR_INVALID_PARAM;
+    }
+
+    ch = &align->channel[align->channel_num];
+    ch->period = seq_period_us * decimate / sample_num;
+    ch->offset = offset_us;
+    /* first output needs a sample before it on every channel */
+    if ((align->channel_num == 0) || (offset_us + ch->period > align->start))
+    {
+        align->start = offset_us + ch->period;
+    }
+    *channel = align->channel_num++;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_align_push(adi_adpd7000_align_t *align, uint8_t channel, double value)
+{
+    uint64_t n;
+    double   x, pos;
+    adi_adpd7000_align_channel_t *ch;
+
+    if (align == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (channel >= align->channel_num)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    ch = &align->channel[channel];
+    ch->hist[ch->count & 3] = value;
+    ch->count++;
+
+    /* outputs whose last tap is the new sample, earlier ones were computed by earlier pushes */
+    for (;;)
+    {
+        pos = (align->start + ch->next_out * align->out_period - ch->offset) / ch->period;
+        x = floor(pos);
+        n = (uint64_t)x;
+        if (n + 2 >= ch->count)
+            break;
+        if ((ch->next_out >= align->emitted) && (ch->next_out - align->emitted >= ADPD7000_ALIGN_QUEUE))
+        {
+            /* slowest channel is a queue behind, give up its oldest output */
+            align->emitted++;
+            align->drop_count++;
+            adi_adpd7000_align_skip(align);
+        }
+        if (ch->next_out >= align->emitted)
+        {
+            ch->out[ch->next_out & (ADPD7000_ALIGN_QUEUE - 1)] = adi_adpd7000_align_cubic(ch->hist, n, pos - x);
+        }
+        ch->next_out++;
+    }
+    adi_adpd7000_align_emit(align);
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
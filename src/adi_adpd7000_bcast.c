@@ -0,0 +1,246 @@
+/*!
+ * @brief     Broadcast Ring APIs Implementation
+ *
+ * Region layout: header, reader_max * reader slot, capacity * element, all cache line padded.
+ * One publisher, any number of readers up to reader_max, each reader has its own tail in the
+ * region and sees every element. Publisher drops when the slowest attached reader is a ring behind.
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_BCAST_MAGIC            (0x43424441)            /*!< "ADBC" */
+#define ADPD7000_BCAST_SLOT_OFFSET      (sizeof(adi_adpd7000_bcast_hdr_t))
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static uint32_t adi_adpd7000_bcast_data_offset(uint32_t reader_max)
+{
+    return ADPD7000_BCAST_SLOT_OFFSET + reader_max * sizeof(adi_adpd7000_bcast_slot_t);
+}
+
+int32_t adi_adpd7000_bcast_get_size(uint32_t elem_size, uint32_t capacity, uint32_t reader_max, uint32_t *size)
+{
+    if (size == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((elem_size == 0) || (capacity == 0) || ((capacity & (capacity - 1)) != 0) || (reader_max == 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    *size = adi_adpd7000_bcast_data_offset(reader_max) + capacity * elem_size;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_create(adi_adpd7000_bcast_t *bcast, void *mem, uint32_t size, uint32_t elem_size, uint32_t capacity,
+    uint32_t reader_max, adi_adpd7000_bcast_notify notify, void *user_data)
+{
+    int32_t  err;
+    uint32_t need;
+
+    if ((bcast == NULL) || (mem == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    err = adi_adpd7000_bcast_get_size(elem_size, capacity, reader_max, &need);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    if (size < need)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    memset(mem, 0, adi_adpd7000_bcast_data_offset(reader_max));
+    bcast->hdr = (adi_adpd7000_bcast_hdr_t *)mem;
+    bcast->slot = (adi_adpd7000_bcast_slot_t *)((uint8_t *)mem + ADPD7000_BCAST_SLOT_OFFSET);
+    bcast->data = (uint8_t *)mem + adi_adpd7000_bcast_data_offset(reader_max);
+    bcast->min_tail = 0;
+    bcast->notify = notify;
+    bcast->user_data = user_data;
+    bcast->hdr->elem_size = elem_size;
+    bcast->hdr->mask = capacity - 1;
+    bcast->hdr->reader_max = reader_max;
+    /* readers may attach once magic is seen */
+    ADPD7000_ATOMIC_STORE_RELEASE(&bcast->hdr->magic, ADPD7000_BCAST_MAGIC);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_reserve(adi_adpd7000_bcast_t *bcast, void **elem)
+{
+    uint32_t i, head, tail, min_tail;
+    adi_adpd7000_bcast_hdr_t *hdr;
+
+    if ((bcast == NULL) || (elem == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    hdr = bcast->hdr;
+    head = hdr->head;
+    /* rescan reader tails only when the cached slowest one blocks */
+    if (head - bcast->min_tail > hdr->mask)
+    {
+        min_tail = head;
+        for (i = 0; i < hdr->reader_max; i++)
+        {
+            if (ADPD7000_ATOMIC_LOAD_ACQUIRE(&bcast->slot[i].active) == 1)
+            {
+                tail = ADPD7000_ATOMIC_LOAD_ACQUIRE(&bcast->slot[i].tail);
+                if (head - tail > head - min_tail)
+                {
+                    min_tail = tail;
+                }
+            }
+        }
+        bcast->min_tail = min_tail;
+        if (head - min_tail > hdr->mask)
+        {
+            ADPD7000_ATOMIC_STORE_RELAXED(&hdr->drop_count, hdr->drop_count + 1);
+            return API_ADPD7000_ERROR_BUFFER_FULL;
+        }
+    }
+    *elem = bcast->data + (head & hdr->mask) * hdr->elem_size;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_commit(adi_adpd7000_bcast_t *bcast)
+{
+    if (bcast == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    ADPD7000_ATOMIC_STORE_RELEASE(&bcast->hdr->head, bcast->hdr->head + 1);
+    if (bcast->notify != NULL)
+    {
+        bcast->notify(bcast->user_data);
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_publish(adi_adpd7000_bcast_t *bcast, const void *elem)
+{
+    int32_t err;
+    void    *slot;
+
+    if (elem == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    err = adi_adpd7000_bcast_reserve(bcast, &slot);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    memcpy(slot, elem, bcast->hdr->elem_size);
+
+    return adi_adpd7000_bcast_commit(bcast);
+}
+
+int32_t adi_adpd7000_bcast_get_stats(adi_adpd7000_bcast_t *bcast, uint32_t *reader_num, uint32_t *drop_count)
+{
+    uint32_t i, n = 0;
+
+    if (bcast == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    if (reader_num != NULL)
+    {
+        for (i = 0; i < bcast->hdr->reader_max; i++)
+        {
+            n += (ADPD7000_ATOMIC_LOAD_RELAXED(&bcast->slot[i].active) == 1) ? 1 : 0;
+        }
+        *reader_num = n;
+    }
+    if (drop_count != NULL)
+    {
+        *drop_count = ADPD7000_ATOMIC_LOAD_RELAXED(&bcast->hdr->drop_count);
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+void adi_adpd7000_bcast_frame_cb(void *user_data, const adi_adpd7000_frame_t *frame)
+{
+    adi_adpd7000_bcast_publish((adi_adpd7000_bcast_t *)user_data, frame);
+}
+
+int32_t adi_adpd7000_bcast_attach(adi_adpd7000_bcast_reader_t *reader, void *mem, uint32_t size)
+{
+    uint32_t i, free_slot, need;
+    adi_adpd7000_bcast_hdr_t *hdr = (adi_adpd7000_bcast_hdr_t *)mem;
+    adi_adpd7000_bcast_slot_t *slot;
+
+    if ((reader == NULL) || (mem == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((size < sizeof(adi_adpd7000_bcast_hdr_t)) || (ADPD7000_ATOMIC_LOAD_ACQUIRE(&hdr->magic) != ADPD7000_BCAST_MAGIC))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if ((adi_adpd7000_bcast_get_size(hdr->elem_size, hdr->mask + 1, hdr->reader_max, &need) != API_ADPD7000_ERROR_OK) || (size < need))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    slot = (adi_adpd7000_bcast_slot_t *)((uint8_t *)mem + ADPD7000_BCAST_SLOT_OFFSET);
+    for (i = 0; i < hdr->reader_max; i++)
+    {
+        free_slot = 0;
+        if (ADPD7000_ATOMIC_CAS(&slot[i].active, &free_slot, 1))
+        {
+            /* a stale tail only makes the publisher wait, start at head once publisher sees the slot */
+            ADPD7000_ATOMIC_STORE_RELEASE(&slot[i].tail, ADPD7000_ATOMIC_LOAD_ACQUIRE(&hdr->head));
+            reader->hdr = hdr;
+            reader->slot = &slot[i];
+            reader->data = (const uint8_t *)mem + adi_adpd7000_bcast_data_offset(hdr->reader_max);
+            return API_ADPD7000_ERROR_OK;
+        }
+    }
+
+    return API_ADPD7000_ERROR_BUFFER_FULL;
+}
+
+int32_t adi_adpd7000_bcast_detach(adi_adpd7000_bcast_reader_t *reader)
+{
+    if ((reader == NULL) || (reader->slot == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    ADPD7000_ATOMIC_STORE_RELEASE(&reader->slot->active, 0);
+    reader->slot = NULL;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_peek(adi_adpd7000_bcast_reader_t *reader, const void **elem)
+{
+    uint32_t head, tail;
+
+    if ((reader == NULL) || (reader->slot == NULL) || (elem == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    tail = reader->slot->tail;
+    head = ADPD7000_ATOMIC_LOAD_ACQUIRE(&reader->hdr->head);
+    if (head == tail)
+        return API_ADPD7000_ERROR_BUFFER_EMPTY;
+    *elem = reader->data + (tail & reader->hdr->mask) * reader->hdr->elem_size;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_release(adi_adpd7000_bcast_reader_t *reader)
+{
+    if ((reader == NULL) || (reader->slot == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    ADPD7000_ATOMIC_STORE_RELEASE(&reader->slot->tail, reader->slot->tail + 1);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_bcast_get_count(adi_adpd7000_bcast_reader_t *reader, uint32_t *count)
+{
+    if ((reader == NULL) || (reader->slot == NULL) || (count == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    *count = ADPD7000_ATOMIC_LOAD_ACQUIRE(&reader->hdr->head) - reader->slot->tail;
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -0,0 +1,481 @@
+/*!
+ * @brief     Raw FIFO Capture APIs Implementation
+ *
+ * Capture layout, all fields little endian:
+ *   header  : magic[8], version u16, reg_num u16, fifo config (ADPD7000_CAPTURE_FIFO_SIZE bytes),
+ *             slot_freq u32, ts_clk u32, reg_num * (addr u16, value u16)
+ *   chunk   : size u32, stamp u32, delta u16, reserved u16, size bytes of raw FIFO data
+ *   index   : chunk_count * (offset u64, first_seq u64)
+ *   trailer : index offset u64, chunk_count u32, sequence total u64, magic[4]
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_CAPTURE_FIFO_SIZE      (4 + 11 + 4 * ADPD7000_PPG_MAX_SLOT)
+#define ADPD7000_CAPTURE_HEADER_SIZE    (8 + 2 + 2 + ADPD7000_CAPTURE_FIFO_SIZE + 4 + 4)
+#define ADPD7000_CAPTURE_CHUNK_SIZE     (12)
+#define ADPD7000_CAPTURE_INDEX_SIZE     (16)
+#define ADPD7000_CAPTURE_TRAILER_SIZE   (24)
+
+/*============= D A T A ====================*/
+static const uint8_t capture_magic[8] = {'A', 'D', 'P', 'D', '7', 'C', 'A', 'P'};
+static const uint8_t capture_index_magic[4] = {'A', 'I', 'D', 'X'};
+
+/*============= C O D E ====================*/
+static void adi_adpd7000_capture_put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void adi_adpd7000_capture_put32(uint8_t *p, uint32_t v)
+{
+    adi_adpd7000_capture_put16(p, (uint16_t)v);
+    adi_adpd7000_capture_put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static void adi_adpd7000_capture_put64(uint8_t *p, uint64_t v)
+{
+    adi_adpd7000_capture_put32(p, (uint32_t)v);
+    adi_adpd7000_capture_put32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint16_t adi_adpd7000_capture_get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t adi_adpd7000_capture_get32(const uint8_t *p)
+{
+    return adi_adpd7000_capture_get16(p) | ((uint32_t)adi_adpd7000_capture_get16(p + 2) << 16);
+}
+
+static uint64_t adi_adpd7000_capture_get64(const uint8_t *p)
+{
+    return adi_adpd7000_capture_get32(p) | ((uint64_t)adi_adpd7000_capture_get32(p + 4) << 32);
+}
+
+static int32_t adi_adpd7000_capture_append(adi_adpd7000_capture_writer_t *writer, const uint8_t *data, uint32_t len)
+{
+    int32_t err;
+
+    err = writer->write(writer->user_data, data, len);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    writer->offset += len;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+/* layout must add up to sequence_size bytes, decoders trust it */
+static int32_t adi_adpd7000_capture_check_fifo(adi_adpd7000_fifo_config_t *fifo)
+{
+    uint8_t  i;
+    uint32_t size;
+    adi_adpd7000_ppg_fifo_config_t *ppg;
+
+    if ((fifo->ecg_slot > 1) || (fifo->ecg_over_sample > ADPD7000_ECG_MAX_OVER_SAMPLE) || (fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT) ||
+        (fifo->bioz_slot > ADPD7000_BIOZ_MAX_SLOT))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (fifo->ecg_slot && (fifo->ecg_size != 3) && (fifo->ecg_size != 4))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if ((fifo->seq_num_en > 1) || (fifo->stat_lev0_en > 1) || (fifo->stat_lev1_en > 1) || (fifo->stat_levx_en > 1))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    size = fifo->ecg_slot * fifo->ecg_over_sample * fifo->ecg_size;
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        ppg = &fifo->ppg_fifo[i];
+        if ((ppg->ppg_chl2_en > 3) || (ppg->signal_size > 4) || (ppg->dark_size > 4) || (ppg->lit_size > 4))
+            return API_ADPD7000_ERROR_INVALID_PARAM;
+        size += (ppg->signal_size + ppg->dark_size + ppg->lit_size) * (1 + ppg->ppg_chl2_en);
+    }
+    size += 6 * fifo->bioz_slot;
+    if (fifo->status_size != fifo->seq_num_en * ADPD7000_SEQ_NUM_SIZE + fifo->stat_lev0_en * ADPD7000_STAT_LEV0_SIZE +
+        fifo->stat_lev1_en * ADPD7000_STAT_LEV1_SIZE + fifo->stat_levx_en * ADPD7000_STAT_LEVX_SIZE)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    size += fifo->status_size;
+    if ((size == 0) || (size != fifo->sequence_size))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_writer_init(adi_adpd7000_capture_writer_t *writer, adi_adpd7000_capture_write write, void *user_data,
+    adi_adpd7000_capture_index_t *index, uint32_t index_capacity)
+{
+    if ((writer == NULL) || (write == NULL) || (index == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (index_capacity == 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    memset(writer, 0, sizeof(adi_adpd7000_capture_writer_t));
+    writer->write = write;
+    writer->user_data = user_data;
+    writer->index = index;
+    writer->index_capacity = index_capacity;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_write_header(adi_adpd7000_capture_writer_t *writer, adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo,
+    const uint16_t *reg_addr, uint16_t reg_num, uint32_t slot_freq, uint32_t ts_clk)
+{
+    int32_t  err;
+    uint16_t i, reg_data;
+    uint8_t  header[ADPD7000_CAPTURE_HEADER_SIZE];
+    uint8_t  *p = header;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(writer);
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_INVALID_PARAM_RETURN((reg_num > 0) && (reg_addr == NULL));
+    ADPD7000_INVALID_PARAM_RETURN(adi_adpd7000_capture_check_fifo(fifo) != API_ADPD7000_ERROR_OK);
+    ADPD7000_INVALID_PARAM_RETURN(writer->offset != 0);
+
+    memcpy(p, capture_magic, sizeof(capture_magic));
+    p += sizeof(capture_magic);
+    adi_adpd7000_capture_put16(p, ADPD7000_CAPTURE_VERSION);
+    adi_adpd7000_capture_put16(p + 2, reg_num);
+    p += 4;
+    adi_adpd7000_capture_put32(p, fifo->sequence_size);
+    p += 4;
+    *p++ = fifo->ecg_slot;
+    *p++ = fifo->ecg_over_sample;
+    *p++ = fifo->ecg_size;
+    *p++ = fifo->ppg_slot;
+    *p++ = fifo->ppg_chnl_num;
+    *p++ = fifo->bioz_slot;
+    *p++ = fifo->seq_num_en;
+    *p++ = fifo->stat_lev0_en;
+    *p++ = fifo->stat_lev1_en;
+    *p++ = fifo->stat_levx_en;
+    *p++ = fifo->status_size;
+    for (i = 0; i < ADPD7000_PPG_MAX_SLOT; i++)
+    {
+        *p++ = fifo->ppg_fifo[i].ppg_chl2_en;
+        *p++ = fifo->ppg_fifo[i].signal_size;
+        *p++ = fifo->ppg_fifo[i].dark_size;
+        *p++ = fifo->ppg_fifo[i].lit_size;
+    }
+    adi_adpd7000_capture_put32(p, slot_freq);
+    adi_adpd7000_capture_put32(p + 4, ts_clk);
+    err = adi_adpd7000_capture_append(writer, header, sizeof(header));
+    ADPD7000_ERROR_RETURN(err);
+
+    for (i = 0; i < reg_num; i++)
+    {
+        err = adi_adpd7000_hal_reg_read(device, reg_addr[i], &reg_data);
+        ADPD7000_ERROR_RETURN(err);
+        adi_adpd7000_capture_put16(header, reg_addr[i]);
+        adi_adpd7000_capture_put16(header + 2, reg_data);
+        err = adi_adpd7000_capture_append(writer, header, 4);
+        ADPD7000_ERROR_RETURN(err);
+    }
+    writer->fifo = *fifo;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_write_chunk(adi_adpd7000_capture_writer_t *writer, const uint8_t *data, uint32_t size, uint32_t stamp, uint16_t delta)
+{
+    int32_t err;
+    uint8_t header[ADPD7000_CAPTURE_CHUNK_SIZE];
+
+    if ((writer == NULL) || (data == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((writer->fifo.sequence_size == 0) || (size == 0) || ((size % writer->fifo.sequence_size) != 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (writer->chunk_count >= writer->index_capacity)
+        return API_ADPD7000_ERROR_BUFFER_FULL;
+
+    writer->index[writer->chunk_count].offset = writer->offset;
+    writer->index[writer->chunk_count].first_seq = writer->seq_total;
+    adi_adpd7000_capture_put32(header, size);
+    adi_adpd7000_capture_put32(header + 4, stamp);
+    adi_adpd7000_capture_put16(header + 8, delta);
+    adi_adpd7000_capture_put16(header + 10, 0);
+    err = adi_adpd7000_capture_append(writer, header, sizeof(header));
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    err = adi_adpd7000_capture_append(writer, data, size);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    writer->seq_total += size / writer->fifo.sequence_size;
+    writer->chunk_count++;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_close(adi_adpd7000_capture_writer_t *writer)
+{
+    int32_t  err;
+    uint32_t i;
+    uint64_t index_offset;
+    uint8_t  entry[ADPD7000_CAPTURE_TRAILER_SIZE];
+
+    if (writer == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (writer->fifo.sequence_size == 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    index_offset = writer->offset;
+    for (i = 0; i < writer->chunk_count; i++)
+    {
+        adi_adpd7000_capture_put64(entry, writer->index[i].offset);
+        adi_adpd7000_capture_put64(entry + 8, writer->index[i].first_seq);
+        err = adi_adpd7000_capture_append(writer, entry, ADPD7000_CAPTURE_INDEX_SIZE);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+    }
+    adi_adpd7000_capture_put64(entry, index_offset);
+    adi_adpd7000_capture_put32(entry + 8, writer->chunk_count);
+    adi_adpd7000_capture_put64(entry + 12, writer->seq_total);
+    memcpy(entry + 20, capture_index_magic, sizeof(capture_index_magic));
+
+    return adi_adpd7000_capture_append(writer, entry, ADPD7000_CAPTURE_TRAILER_SIZE);
+}
+
+int32_t adi_adpd7000_capture_open(adi_adpd7000_capture_reader_t *reader, const void *base, size_t size)
+{
+    uint16_t i;
+    uint64_t index_offset;
+    const uint8_t *p, *trailer;
+    adi_adpd7000_fifo_config_t *fifo;
+
+    if ((reader == NULL) || (base == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    p = (const uint8_t *)base;
+    if ((size < ADPD7000_CAPTURE_HEADER_SIZE + ADPD7000_CAPTURE_TRAILER_SIZE) || (memcmp(p, capture_magic, sizeof(capture_magic)) != 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (adi_adpd7000_capture_get16(p + 8) != ADPD7000_CAPTURE_VERSION)
+        return API_ADPD7000_ERROR_NOT_SUPPORTED;
+
+    memset(reader, 0, sizeof(adi_adpd7000_capture_reader_t));
+    reader->base = p;
+    reader->size = size;
+    reader->reg_num = adi_adpd7000_capture_get16(p + 10);
+    p += 12;
+    fifo = &reader->fifo;
+    fifo->sequence_size = adi_adpd7000_capture_get32(p);
+    p += 4;
+    fifo->ecg_slot = *p++;
+    fifo->ecg_over_sample = *p++;
+    fifo->ecg_size = *p++;
+    fifo->ppg_slot = *p++;
+    fifo->ppg_chnl_num = *p++;
+    fifo->bioz_slot = *p++;
+    fifo->seq_num_en = *p++;
+    fifo->stat_lev0_en = *p++;
+    fifo->stat_lev1_en = *p++;
+    fifo->stat_levx_en = *p++;
+    fifo->status_size = *p++;
+    for (i = 0; i < ADPD7000_PPG_MAX_SLOT; i++)
+    {
+        fifo->ppg_fifo[i].ppg_chl2_en = *p++;
+        fifo->ppg_fifo[i].signal_size = *p++;
+        fifo->ppg_fifo[i].dark_size = *p++;
+        fifo->ppg_fifo[i].lit_size = *p++;
+    }
+    reader->slot_freq = adi_adpd7000_capture_get32(p);
+    reader->ts_clk = adi_adpd7000_capture_get32(p + 4);
+    reader->regs = p + 8;
+    if (adi_adpd7000_capture_check_fifo(fifo) != API_ADPD7000_ERROR_OK)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (ADPD7000_CAPTURE_HEADER_SIZE + 4 * (size_t)reader->reg_num + ADPD7000_CAPTURE_TRAILER_SIZE > size)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    trailer = reader->base + size - ADPD7000_CAPTURE_TRAILER_SIZE;
+    if (memcmp(trailer + 20, capture_index_magic, sizeof(capture_index_magic)) != 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    index_offset = adi_adpd7000_capture_get64(trailer);
+    reader->chunk_count = adi_adpd7000_capture_get32(trailer + 8);
+    reader->seq_total = adi_adpd7000_capture_get64(trailer + 12);
+    if ((index_offset > size) || ((size - index_offset - ADPD7000_CAPTURE_TRAILER_SIZE) / ADPD7000_CAPTURE_INDEX_SIZE != reader->chunk_count))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    reader->index = reader->base + index_offset;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_get_reg(adi_adpd7000_capture_reader_t *reader, uint16_t index, uint16_t *reg_addr, uint16_t *reg_data)
+{
+    if ((reader == NULL) || (reg_addr == NULL) || (reg_data == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (index >= reader->reg_num)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    *reg_addr = adi_adpd7000_capture_get16(reader->regs + 4 * index);
+    *reg_data = adi_adpd7000_capture_get16(reader->regs + 4 * index + 2);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_get_chunk(adi_adpd7000_capture_reader_t *reader, uint32_t index, adi_adpd7000_capture_chunk_t *chunk)
+{
+    uint64_t offset;
+    const uint8_t *p;
+
+    if ((reader == NULL) || (chunk == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (index >= reader->chunk_count)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    offset = adi_adpd7000_capture_get64(reader->index + (size_t)index * ADPD7000_CAPTURE_INDEX_SIZE);
+    if (offset + ADPD7000_CAPTURE_CHUNK_SIZE > (uint64_t)(reader->index - reader->base))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    p = reader->base + offset;
+    chunk->size = adi_adpd7000_capture_get32(p);
+    if (offset + ADPD7000_CAPTURE_CHUNK_SIZE + chunk->size > (uint64_t)(reader->index - reader->base))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    chunk->stamp = adi_adpd7000_capture_get32(p + 4);
+    chunk->delta = adi_adpd7000_capture_get16(p + 8);
+    chunk->data = p + ADPD7000_CAPTURE_CHUNK_SIZE;
+    chunk->seq_count = chunk->size / reader->fifo.sequence_size;
+    chunk->first_seq = adi_adpd7000_capture_get64(reader->index + (size_t)index * ADPD7000_CAPTURE_INDEX_SIZE + 8);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_seek(adi_adpd7000_capture_reader_t *reader, uint64_t seq, uint32_t *index)
+{
+    uint32_t low, high, mid;
+
+    if ((reader == NULL) || (index == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((reader->chunk_count == 0) || (seq >= reader->seq_total))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    /* last chunk whose first sequence is not after seq */
+    low = 0;
+    high = reader->chunk_count - 1;
+    while (low < high)
+    {
+        mid = low + (high - low + 1) / 2;
+        if (adi_adpd7000_capture_get64(reader->index + (size_t)mid * ADPD7000_CAPTURE_INDEX_SIZE + 8) <= seq)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    *index = low;
+
+    return API_ADPD7000_ERROR_OK;
+}
+int32_t adi_adpd7000_capture_split(adi_adpd7000_capture_reader_t *reader, uint32_t worker_num, uint32_t worker, uint32_t *first_chunk, uint32_t *chunk_num)
+{
+    int32_t  err;
+    uint32_t start, end;
+
+    if ((reader == NULL) || (first_chunk == NULL) || (chunk_num == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((worker_num == 0) || (worker >= worker_num))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    *first_chunk = 0;
+    *chunk_num = 0;
+    if (reader->seq_total == 0)
+        return API_ADPD7000_ERROR_OK;
+
+    /* a chunk belongs to the worker whose sequence range holds its first sequence */
+    start = 0;
+    end = reader->chunk_count;
+    if (worker > 0)
+    {
+        err = adi_adpd7000_capture_seek(reader, reader->seq_total * worker / worker_num, &start);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+        if (adi_adpd7000_capture_get64(reader->index + (size_t)start * ADPD7000_CAPTURE_INDEX_SIZE + 8) < reader->seq_total * worker / worker_num)
+            start++;
+    }
+    if (worker < worker_num - 1)
+    {
+        err = adi_adpd7000_capture_seek(reader, reader->seq_total * (worker + 1) / worker_num, &end);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+        if (adi_adpd7000_capture_get64(reader->index + (size_t)end * ADPD7000_CAPTURE_INDEX_SIZE + 8) < reader->seq_total * (worker + 1) / worker_num)
+            end++;
+    }
+    *first_chunk = start;
+    *chunk_num = (end > start) ? (end - start) : 0;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_capture_decode_columns(adi_adpd7000_capture_reader_t *reader, uint32_t first_chunk, uint32_t chunk_num,
+    uint32_t *columns, uint64_t row_base, uint64_t row_stride)
+{
+    int32_t  err;
+    uint32_t i, j, value;
+    uint16_t c, k, col_num, ecg_num, ecg_col;
+    uint8_t  sizes[ADPD7000_FIFO_MAX_COLUMN];
+    uint8_t  filler;
+    uint64_t row;
+    const uint8_t *p;
+    adi_adpd7000_capture_chunk_t chunk;
+
+    if ((reader == NULL) || (columns == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((first_chunk > reader->chunk_count) || (chunk_num > reader->chunk_count - first_chunk))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    err = adi_adpd7000_fifo_get_column_sizes(&reader->fifo, sizes, ADPD7000_FIFO_MAX_COLUMN, &col_num);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    /* same filler rule as adi_adpd7000_fifo_decode_frame */
+    ecg_num = reader->fifo.ecg_slot * reader->fifo.ecg_over_sample;
+    filler = (reader->fifo.ecg_size == 4) && ((reader->fifo.ppg_slot != 0) || (reader->fifo.bioz_slot != 0));
+
+    for (i = first_chunk; i < first_chunk + chunk_num; i++)
+    {
+        err = adi_adpd7000_capture_get_chunk(reader, i, &chunk);
+        if (err != API_ADPD7000_ERROR_OK)
+            return err;
+        if ((chunk.first_seq < row_base) || (chunk.first_seq + chunk.seq_count - row_base > row_stride))
+            return API_ADPD7000_ERROR_INVALID_PARAM;
+
+        p = chunk.data;
+        row = chunk.first_seq - row_base;
+        for (j = 0; j < chunk.seq_count; j++, row++)
+        {
+            ecg_col = 0;
+            for (c = 0; c < col_num; c++)
+            {
+                if ((c < ecg_num) && filler && (p[0] == 0xff))
+                {
+                    p += sizes[c];
+                    continue;
+                }
+                value = 0;
+                for (k = 0; k < sizes[c]; k++)
+                {
+                    value = (value << 8) | *p++;
+                }
+                if (c < ecg_num)
+                    columns[ecg_col++ * row_stride + row] = value;
+                else
+                    columns[c * row_stride + row] = value;
+            }
+            for (; ecg_col < ecg_num; ecg_col++)
+            {
+                columns[ecg_col * row_stride + row] = ADPD7000_FIFO_ECG_FILLER;
+            }
+        }
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
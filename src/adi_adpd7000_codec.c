@@ -0,0 +1,376 @@
+/*!
+ * @brief     Lossless Sample Codec APIs Implementation
+ *
+ * Block layout, header little endian, payload MSB first bit stream:
+ *   header  : row_num u16, column_num u16, payload size u32
+ *   payload : column_num * (order 2 bits, k 5 bits, order * 32 bits warm up values,
+ *             (row_num - order) * Rice coded residuals), padded to byte
+ * Residual of order 0 is the value, of order 1/2 the zigzag of first/second difference,
+ * modulo 2^32 so any 32 bits value is lossless.
+ * Rice code is q ones, one zero and k low bits of q = z >> k, q >= ADPD7000_CODEC_ESCAPE is
+ * sent as ADPD7000_CODEC_ESCAPE ones followed by raw 32 bits residual.
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#if ADPD7000_CODEC_SSE2
+#include <emmintrin.h>
+#endif
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_CODEC_HEADER_SIZE      (8)
+#define ADPD7000_CODEC_MAX_ORDER        (2)
+#define ADPD7000_CODEC_MAX_K            (31)
+#define ADPD7000_CODEC_ESCAPE           (24)
+
+typedef struct
+{
+    uint8_t  *buf;
+    uint32_t size;
+    uint32_t pos;
+    uint64_t acc;
+    uint32_t bits;
+    uint8_t  full;
+} adi_adpd7000_codec_bit_writer_t;
+
+typedef struct
+{
+    const uint8_t *buf;
+    uint32_t size;
+    uint32_t pos;
+    uint64_t acc;
+    uint32_t bits;
+    uint8_t  empty;
+} adi_adpd7000_codec_bit_reader_t;
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static void adi_adpd7000_codec_put_bits(adi_adpd7000_codec_bit_writer_t *bw, uint32_t value, uint32_t n)
+{
+    if (n == 0)
+        return;
+    bw->acc = (bw->acc << n) | (value & (uint32_t)(0xffffffffu >> (32 - n)));
+    bw->bits += n;
+    while (bw->bits >= 8)
+    {
+        bw->bits -= 8;
+        if (bw->pos < bw->size)
+        {
+            bw->buf[bw->pos++] = (uint8_t)(bw->acc >> bw->bits);
+        }
+        else
+        {
+            bw->full = 1;
+        }
+    }
+}
+
+static void adi_adpd7000_codec_put_rice(adi_adpd7000_codec_bit_writer_t *bw, uint32_t z, uint8_t k)
+{
+    uint32_t q = z >> k;
+
+    if (q < ADPD7000_CODEC_ESCAPE)
+    {
+        /* q ones, one zero, k low bits */
+        adi_adpd7000_codec_put_bits(bw, (1u << (q + 1)) - 2, q + 1);
+        adi_adpd7000_codec_put_bits(bw, z, k);
+    }
+    else
+    {
+        adi_adpd7000_codec_put_bits(bw, (1u << ADPD7000_CODEC_ESCAPE) - 1, ADPD7000_CODEC_ESCAPE);
+        adi_adpd7000_codec_put_bits(bw, z, 32);
+    }
+}
+
+static uint32_t adi_adpd7000_codec_get_bits(adi_adpd7000_codec_bit_reader_t *br, uint32_t n)
+{
+    if (n == 0)
+        return 0;
+    while (br->bits < n)
+    {
+        if (br->pos < br->size)
+        {
+            br->acc = (br->acc << 8) | br->buf[br->pos++];
+        }
+        else
+        {
+            br->acc <<= 8;
+            br->empty = 1;
+        }
+        br->bits += 8;
+    }
+    br->bits -= n;
+
+    return (uint32_t)(br->acc >> br->bits) & (0xffffffffu >> (32 - n));
+}
+
+static uint32_t adi_adpd7000_codec_get_rice(adi_adpd7000_codec_bit_reader_t *br, uint8_t k)
+{
+    uint32_t q = 0;
+
+    while ((q < ADPD7000_CODEC_ESCAPE) && adi_adpd7000_codec_get_bits(br, 1))
+    {
+        q++;
+    }
+    if (q == ADPD7000_CODEC_ESCAPE)
+        return adi_adpd7000_codec_get_bits(br, 32);
+
+    return (q << k) | adi_adpd7000_codec_get_bits(br, k);
+}
+
+static uint32_t adi_adpd7000_codec_zigzag(uint32_t r)
+{
+    return (r << 1) ^ (0u - (r >> 31));
+}
+
+static uint32_t adi_adpd7000_codec_unzigzag(uint32_t z)
+{
+    return (z >> 1) ^ (0u - (z & 1));
+}
+
+/* zigzag first and second difference of v for rows 2 ~ n - 1 */
+static void adi_adpd7000_codec_residual(const uint32_t *v, uint16_t n, uint32_t *z1, uint32_t *z2)
+{
+    uint16_t i = ADPD7000_CODEC_MAX_ORDER;
+#if ADPD7000_CODEC_SSE2
+    __m128i x0, x1, x2, d1, d2;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        x0 = _mm_loadu_si128((const __m128i *)(v + i));
+        x1 = _mm_loadu_si128((const __m128i *)(v + i - 1));
+        x2 = _mm_loadu_si128((const __m128i *)(v + i - 2));
+        d1 = _mm_sub_epi32(x0, x1);
+        d2 = _mm_sub_epi32(d1, _mm_sub_epi32(x1, x2));
+        _mm_storeu_si128((__m128i *)(z1 + i), _mm_xor_si128(_mm_slli_epi32(d1, 1), _mm_srai_epi32(d1, 31)));
+        _mm_storeu_si128((__m128i *)(z2 + i), _mm_xor_si128(_mm_slli_epi32(d2, 1), _mm_srai_epi32(d2, 31)));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        z1[i] = adi_adpd7000_codec_zigzag(v[i] - v[i - 1]);
+        z2[i] = adi_adpd7000_codec_zigzag(v[i] - 2 * v[i - 1] + v[i - 2]);
+    }
+}
+
+/* x[i] += x[i - 1] for i = 0 ~ n - 1, x[-1] = carry */
+static void adi_adpd7000_codec_prefix_sum(uint32_t *x, uint16_t n, uint32_t carry)
+{
+    uint16_t i = 0;
+#if ADPD7000_CODEC_SSE2
+    __m128i s, c = _mm_set1_epi32((int)carry);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        s = _mm_loadu_si128((const __m128i *)(x + i));
+        s = _mm_add_epi32(s, _mm_slli_si128(s, 4));
+        s = _mm_add_epi32(s, _mm_slli_si128(s, 8));
+        s = _mm_add_epi32(s, c);
+        _mm_storeu_si128((__m128i *)(x + i), s);
+        c = _mm_shuffle_epi32(s, 0xff);
+    }
+    carry = (uint32_t)_mm_cvtsi128_si32(c);
+#endif
+    for (; i < n; i++)
+    {
+        carry += x[i];
+        x[i] = carry;
+    }
+}
+
+int32_t adi_adpd7000_codec_encode_block(const uint32_t *values, uint32_t row_stride, uint16_t row_num, uint16_t column_num,
+    uint8_t *out, uint32_t out_size, uint32_t *out_len)
+{
+    uint16_t c, i;
+    uint8_t  order, k;
+    uint32_t v[ADPD7000_CODEC_MAX_ROWS];
+    uint32_t z[ADPD7000_CODEC_MAX_ORDER + 1][ADPD7000_CODEC_MAX_ROWS];
+    uint64_t cost[ADPD7000_CODEC_MAX_ORDER + 1], sum;
+    adi_adpd7000_codec_bit_writer_t bw;
+
+    if ((values == NULL) || (out == NULL) || (out_len == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((row_num == 0) || (row_num > ADPD7000_CODEC_MAX_ROWS) || (row_num > row_stride) || (column_num == 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (out_size < ADPD7000_CODEC_HEADER_SIZE)
+        return API_ADPD7000_ERROR_BUFFER_FULL;
+
+    bw.buf = out + ADPD7000_CODEC_HEADER_SIZE;
+    bw.size = out_size - ADPD7000_CODEC_HEADER_SIZE;
+    bw.pos = 0;
+    bw.acc = 0;
+    bw.bits = 0;
+    bw.full = 0;
+
+    for (c = 0; c < column_num; c++)
+    {
+        for (i = 0; i < row_num; i++)
+        {
+            v[i] = values[c * row_stride + i];
+            z[0][i] = v[i];
+        }
+        adi_adpd7000_codec_residual(v, row_num, z[1], z[2]);
+
+        /* predictor with least residual magnitude over rows every predictor covers */
+        order = 0;
+        if (row_num > ADPD7000_CODEC_MAX_ORDER)
+        {
+            cost[0] = cost[1] = cost[2] = 0;
+            for (i = ADPD7000_CODEC_MAX_ORDER; i < row_num; i++)
+            {
+                cost[0] += z[0][i];
+                cost[1] += z[1][i];
+                cost[2] += z[2][i];
+            }
+            order = (cost[1] < cost[0]) ? 1 : 0;
+            order = (cost[2] < cost[order]) ? 2 : order;
+        }
+        if (order == 1)
+        {
+            z[1][1] = adi_adpd7000_codec_zigzag(v[1] - v[0]);
+        }
+
+        /* Rice parameter close to log2 of mean residual */
+        sum = 0;
+        for (i = order; i < row_num; i++)
+        {
+            sum += z[order][i];
+        }
+        k = 0;
+        while ((k < ADPD7000_CODEC_MAX_K) && (((uint64_t)(row_num - order) << (k + 1)) <= sum))
+        {
+            k++;
+        }
+
+        adi_adpd7000_codec_put_bits(&bw, order, 2);
+        adi_adpd7000_codec_put_bits(&bw, k, 5);
+        for (i = 0; i < order; i++)
+        {
+            adi_adpd7000_codec_put_bits(&bw, v[i], 32);
+        }
+        for (i = order; i < row_num; i++)
+        {
+            adi_adpd7000_codec_put_rice(&bw, z[order][i], k);
+        }
+    }
+    if (bw.bits > 0)
+    {
+        adi_adpd7000_codec_put_bits(&bw, 0, 8 - bw.bits);
+    }
+    if (bw.full)
+        return API_ADPD7000_ERROR_BUFFER_FULL;
+
+    out[0] = (uint8_t)row_num;
+    out[1] = (uint8_t)(row_num >> 8);
+    out[2] = (uint8_t)column_num;
+    out[3] = (uint8_t)(column_num >> 8);
+    out[4] = (uint8_t)bw.pos;
+    out[5] = (uint8_t)(bw.pos >> 8);
+    out[6] = (uint8_t)(bw.pos >> 16);
+    out[7] = (uint8_t)(bw.pos >> 24);
+    *out_len = ADPD7000_CODEC_HEADER_SIZE + bw.pos;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_codec_get_block_info(const uint8_t *in, uint32_t in_size, uint16_t *row_num, uint16_t *column_num, uint32_t *block_size)
+{
+    uint32_t payload;
+
+    if (in == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (in_size < ADPD7000_CODEC_HEADER_SIZE)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    payload = in[4] | (in[5] << 8) | ((uint32_t)in[6] << 16) | ((uint32_t)in[7] << 24);
+    if (payload > in_size - ADPD7000_CODEC_HEADER_SIZE)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (row_num != NULL)
+    {
+        *row_num = (uint16_t)(in[0] | (in[1] << 8));
+    }
+    if (column_num != NULL)
+    {
+        *column_num = (uint16_t)(in[2] | (in[3] << 8));
+    }
+    if (block_size != NULL)
+    {
+        *block_size = ADPD7000_CODEC_HEADER_SIZE + payload;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_codec_decode_block(const uint8_t *in, uint32_t in_size, uint32_t *values, uint32_t row_stride, uint32_t *block_size)
+{
+    int32_t  err;
+    uint16_t row_num, column_num, c, i;
+    uint8_t  order, k;
+    uint32_t size;
+    uint32_t *v;
+    adi_adpd7000_codec_bit_reader_t br;
+
+    if (values == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    err = adi_adpd7000_codec_get_block_info(in, in_size, &row_num, &column_num, &size);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    if ((row_num == 0) || (row_num > ADPD7000_CODEC_MAX_ROWS) || (row_num > row_stride))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    br.buf = in + ADPD7000_CODEC_HEADER_SIZE;
+    br.size = size - ADPD7000_CODEC_HEADER_SIZE;
+    br.pos = 0;
+    br.acc = 0;
+    br.bits = 0;
+    br.empty = 0;
+
+    for (c = 0; c < column_num; c++)
+    {
+        v = values + c * row_stride;
+        order = (uint8_t)adi_adpd7000_codec_get_bits(&br, 2);
+        k = (uint8_t)adi_adpd7000_codec_get_bits(&br, 5);
+        if ((order > ADPD7000_CODEC_MAX_ORDER) || ((order > 0) && (order >= row_num)))
+            return API_ADPD7000_ERROR_INVALID_PARAM;
+        for (i = 0; i < order; i++)
+        {
+            v[i] = adi_adpd7000_codec_get_bits(&br, 32);
+        }
+        for (i = order; i < row_num; i++)
+        {
+            v[i] = adi_adpd7000_codec_get_rice(&br, k);
+            if (order > 0)
+            {
+                v[i] = adi_adpd7000_codec_unzigzag(v[i]);
+            }
+        }
+
+        /* undo differences, second order is a prefix sum of the first differences */
+        if (order == 2)
+        {
+            adi_adpd7000_codec_prefix_sum(v + 2, row_num - 2, v[1] - v[0]);
+            adi_adpd7000_codec_prefix_sum(v + 2, row_num - 2, v[1]);
+        }
+        else if (order == 1)
+        {
+            adi_adpd7000_codec_prefix_sum(v + 1, row_num - 1, v[0]);
+        }
+    }
+    if (br.empty)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    if (block_size != NULL)
+    {
+        *block_size = size;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -108,6 +108,64 @@ int32_t adi_adpd7000_device_set_fifo_threshold(adi_adpd7000_device_t *device, ui
     return API_ADPD7000_ERROR_OK;
 }
 
+int32_t adi_adpd7000_device_set_fifo_threshold_auto(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, uint32_t freq, uint32_t latency_us, uint16_t *threshold)
+{
+    int32_t  err;
+    uint32_t seq_num, seq_margin;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_INVALID_PARAM_RETURN((fifo->sequence_size == 0) || (fifo->sequence_size > ADPD7000_FIFO_SIZE));
+
+    /* sequences pushed into FIFO while host is waking up, rounded up */
+    seq_margin = (uint32_t)(((uint64_t)latency_us * freq + 999999) / 1000000);
+    seq_num = ADPD7000_FIFO_SIZE / fifo->sequence_size;
+    if (seq_num > seq_margin)
+    {
+        seq_num -= seq_margin;
+    }
+    else
+    {
+        ADPD7000_LOG_WARN("wake up latency exceeds FIFO depth, threshold set to one sequence");
+        seq_num = 1;
+    }
+
+    err = adi_adpd7000_device_set_fifo_threshold(device, seq_num * fifo->sequence_size - 1);
+    ADPD7000_ERROR_RETURN(err);
+    if (threshold != NULL)
+    {
+        *threshold = seq_num * fifo->sequence_size - 1;
+    }
+    
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_device_update_fifo_threshold(adi_adpd7000_device_t *device, adi_adpd7000_fifo_tune_t *tune, adi_adpd7000_fifo_config_t *fifo)
+{
+    int32_t  err;
+    uint32_t freq;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(tune);
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+
+    err = adi_adpd7000_device_get_sequence_fifo_config(device, fifo);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_device_get_slot_freq(device, tune->sys_clk, &freq);
+    ADPD7000_ERROR_RETURN(err);
+    if ((fifo->sequence_size == tune->sequence_size) && (freq == tune->slot_freq))
+    {
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    err = adi_adpd7000_device_set_fifo_threshold_auto(device, fifo, freq, tune->latency_us, &tune->threshold);
+    ADPD7000_ERROR_RETURN(err);
+    tune->sequence_size = fifo->sequence_size;
+    tune->slot_freq = freq;
+    
+    return API_ADPD7000_ERROR_OK;
+}
+
 int32_t adi_adpd7000_device_clr_fifo(adi_adpd7000_device_t *device)
 {
     int32_t  err;
@@ -174,6 +232,21 @@ int32_t adi_adpd7000_device_enable_fifo_thres_interrupt(adi_adpd7000_device_t *d
     return API_ADPD7000_ERROR_OK;
 }
 
+int32_t adi_adpd7000_device_enable_ppg_data_ready_interrupt(adi_adpd7000_device_t *device, adi_adpd7000_interrupt_type_e type, uint8_t slot, bool enable)
+{
+    int32_t err;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_INVALID_PARAM_RETURN(type > API_ADPD7000_INTERRUPT_Y);
+    ADPD7000_INVALID_PARAM_RETURN(slot >= ADPD7000_PPG_MAX_SLOT);
+
+    /* INTY enables follow the INTX level 0 and level 1 registers */
+    err = adi_adpd7000_hal_bf_write(device, 2 * type + BF_INTX_EN_PPG_LEV0_A_INFO + slot, enable ? 1 : 0);
+    ADPD7000_ERROR_RETURN(err);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
 int32_t adi_adpd7000_device_enable_auto_clear_int(adi_adpd7000_device_t *device, bool enable)
 {
     int32_t err;
@@ -245,6 +318,22 @@ int32_t adi_adpd7000_device_get_sequence_fifo_config(adi_adpd7000_device_t *devi
         
     fifo->sequence_size += 6 * fifo->bioz_slot;
 
+    err = adi_adpd7000_hal_bf_read(device, BF_ENA_SEQ_NUM_INFO, &data);
+    ADPD7000_ERROR_RETURN(err);
+    fifo->seq_num_en = data;
+    err = adi_adpd7000_hal_bf_read(device, BF_ENA_STAT_LEV0_INFO, &data);
+    ADPD7000_ERROR_RETURN(err);
+    fifo->stat_lev0_en = data;
+    err = adi_adpd7000_hal_bf_read(device, BF_ENA_STAT_LEV1_INFO, &data);
+    ADPD7000_ERROR_RETURN(err);
+    fifo->stat_lev1_en = data;
+    err = adi_adpd7000_hal_bf_read(device, BF_ENA_STAT_LEVX_INFO, &data);
+    ADPD7000_ERROR_RETURN(err);
+    fifo->stat_levx_en = data;
+    fifo->status_size = fifo->seq_num_en * ADPD7000_SEQ_NUM_SIZE + fifo->stat_lev0_en * ADPD7000_STAT_LEV0_SIZE +
+        fifo->stat_lev1_en * ADPD7000_STAT_LEV1_SIZE + fifo->stat_levx_en * ADPD7000_STAT_LEVX_SIZE;
+    fifo->sequence_size += fifo->status_size;
+
     return API_ADPD7000_ERROR_OK;
 }
 
@@ -307,6 +396,24 @@ int32_t adi_adpd7000_device_set_slot_freq(adi_adpd7000_device_t *device, uint32_
     return API_ADPD7000_ERROR_OK;
 }
 
+int32_t adi_adpd7000_device_get_slot_freq(adi_adpd7000_device_t *device, uint32_t sys_clk, uint32_t *freq)
+{
+    int32_t  err;
+    uint16_t data_l, data_h;
+    uint32_t data;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_NULL_POINTER_RETURN(freq);
+
+    err = adi_adpd7000_hal_bf_read(device, BF_TIMESLOT_PERIOD_L_INFO, &data_l);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_hal_bf_read(device, BF_TIMESLOT_PERIOD_H_INFO, &data_h);
+    ADPD7000_ERROR_RETURN(err);
+    data = ((uint32_t)data_h << 16) | data_l;
+    *freq = (data == 0) ? 0 : (sys_clk / data);
+    
+    return API_ADPD7000_ERROR_OK;
+}
+
 int32_t adi_adpd7000_device_enbale_sleep_mode(adi_adpd7000_device_t *device, bool enable)
 {
     int32_t err;
@@ -0,0 +1,451 @@
+/*!
+ * @brief     FIFO Sequence Frame APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_FIFO_BF_MASK(addr, info) ((uint16_t)(((1UL << ((info) >> 8)) - 1) << ((info) & 0xff))) /*!< Register mask of a bitfield */
+#define ADPD7000_FIFO_MASK(bf)          ADPD7000_FIFO_BF_MASK(bf)
+#define ADPD7000_FIFO_BYTE_COUNT_MASK   ADPD7000_FIFO_MASK(BF_FIFO_BYTE_COUNT_INFO)
+#define ADPD7000_FIFO_TH_MASK           ADPD7000_FIFO_MASK(BF_INT_FIFO_TH_INFO)
+#define ADPD7000_FIFO_OFLOW_MASK        ADPD7000_FIFO_MASK(BF_INT_FIFO_OFLOW_INFO)
+#define ADPD7000_FIFO_UFLOW_MASK        ADPD7000_FIFO_MASK(BF_INT_FIFO_UFLOW_INFO)
+#define ADPD7000_FIFO_DISCARD_CHUNK     (32)
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static uint32_t adi_adpd7000_fifo_get_value(const uint8_t *data, uint8_t size)
+{
+    uint32_t value = 0;
+    uint8_t  k;
+
+    for (k = 0; k < size; k++)
+    {
+        value = (value << 8) | data[k];
+    }
+
+    return value;
+}
+
+static void adi_adpd7000_fifo_get_status_bytes(adi_adpd7000_fifo_config_t *fifo, const uint8_t *data, adi_adpd7000_fifo_status_bytes_t *status)
+{
+    status->seq_num = 0;
+    status->lev0 = 0;
+    status->lev1 = 0;
+    status->levx = 0;
+    if (fifo->seq_num_en)
+    {
+        status->seq_num = (uint8_t)adi_adpd7000_fifo_get_value(data, ADPD7000_SEQ_NUM_SIZE);
+        data += ADPD7000_SEQ_NUM_SIZE;
+    }
+    if (fifo->stat_lev0_en)
+    {
+        status->lev0 = (uint16_t)adi_adpd7000_fifo_get_value(data, ADPD7000_STAT_LEV0_SIZE);
+        data += ADPD7000_STAT_LEV0_SIZE;
+    }
+    if (fifo->stat_lev1_en)
+    {
+        status->lev1 = (uint16_t)adi_adpd7000_fifo_get_value(data, ADPD7000_STAT_LEV1_SIZE);
+        data += ADPD7000_STAT_LEV1_SIZE;
+    }
+    if (fifo->stat_levx_en)
+    {
+        status->levx = adi_adpd7000_fifo_get_value(data, ADPD7000_STAT_LEVX_SIZE);
+    }
+}
+
+static int32_t adi_adpd7000_fifo_discard_bytes(adi_adpd7000_device_t *device, uint32_t len)
+{
+    int32_t  err;
+    uint32_t chunk;
+    uint8_t  fifo_data[ADPD7000_FIFO_DISCARD_CHUNK];
+
+    while (len > 0)
+    {
+        chunk = (len > sizeof(fifo_data)) ? sizeof(fifo_data) : len;
+        err = adi_adpd7000_device_fifo_read_bytes(device, fifo_data, chunk);
+        ADPD7000_ERROR_RETURN(err);
+        len -= chunk;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_decode_frame(adi_adpd7000_fifo_config_t *fifo, const uint8_t *data, adi_adpd7000_frame_t *frame)
+{
+    uint8_t i, j;
+    adi_adpd7000_ppg_fifo_config_t *ppg;
+
+    if ((fifo == NULL) || (data == NULL) || (frame == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((fifo->ecg_over_sample > ADPD7000_ECG_MAX_OVER_SAMPLE) || (fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT) || (fifo->bioz_slot > ADPD7000_BIOZ_MAX_SLOT))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    frame->ecg_num = 0;
+    if (fifo->ecg_slot)
+    {
+        for (i = 0; i < fifo->ecg_over_sample; i++, data += fifo->ecg_size)
+        {
+            if ((data[0] == 0xff) && (fifo->ecg_size == 4) && ((fifo->ppg_slot != 0) || (fifo->bioz_slot != 0)))
+            {
+                continue;
+            }
+            if (fifo->ecg_size == 4)
+            {
+                frame->ecg_status[frame->ecg_num] = data[0];
+                frame->ecg_data[frame->ecg_num] = adi_adpd7000_fifo_get_value(data + 1, 3);
+            }
+            else
+            {
+                frame->ecg_status[frame->ecg_num] = 0;
+                frame->ecg_data[frame->ecg_num] = adi_adpd7000_fifo_get_value(data, 3);
+            }
+            frame->ecg_num++;
+        }
+    }
+
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        ppg = &fifo->ppg_fifo[i];
+        for (j = 0; j <= ppg->ppg_chl2_en; j++)
+        {
+            frame->ppg_signal[i].chnl[j] = adi_adpd7000_fifo_get_value(data, ppg->signal_size);
+            data += ppg->signal_size;
+            frame->ppg_dark[i].chnl[j] = adi_adpd7000_fifo_get_value(data, ppg->dark_size);
+            data += ppg->dark_size;
+            frame->ppg_lit[i].chnl[j] = adi_adpd7000_fifo_get_value(data, ppg->lit_size);
+            data += ppg->lit_size;
+        }
+    }
+    frame->ppg_slot_num = fifo->ppg_slot;
+
+    for (i = 0; i < fifo->bioz_slot; i++, data += 6)
+    {
+        frame->bioz[i].real = adi_adpd7000_fifo_get_value(data, 3);
+        frame->bioz[i].imag = adi_adpd7000_fifo_get_value(data + 3, 3);
+    }
+    frame->bioz_num = fifo->bioz_slot;
+    adi_adpd7000_fifo_get_status_bytes(fifo, data, &frame->status);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_read_frame(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_frame_t *frame)
+{
+    int32_t err;
+    uint8_t fifo_data[ADPD7000_FIFO_SIZE];
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_NULL_POINTER_RETURN(frame);
+    ADPD7000_INVALID_PARAM_RETURN((fifo->sequence_size == 0) || (fifo->sequence_size > ADPD7000_FIFO_SIZE));
+
+    err = adi_adpd7000_device_fifo_read_bytes(device, fifo_data, fifo->sequence_size);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_fifo_decode_frame(fifo, fifo_data, frame);
+    ADPD7000_ERROR_RETURN(err);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_read_status_bytes(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_status_bytes_t *status)
+{
+    int32_t err;
+    uint8_t fifo_data[ADPD7000_SEQ_NUM_SIZE + ADPD7000_STAT_LEV0_SIZE + ADPD7000_STAT_LEV1_SIZE + ADPD7000_STAT_LEVX_SIZE];
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_NULL_POINTER_RETURN(status);
+    ADPD7000_INVALID_PARAM_RETURN(fifo->status_size > sizeof(fifo_data));
+
+    if (fifo->status_size > 0)
+    {
+        err = adi_adpd7000_device_fifo_read_bytes(device, fifo_data, fifo->status_size);
+        ADPD7000_ERROR_RETURN(err);
+    }
+    adi_adpd7000_fifo_get_status_bytes(fifo, fifo_data, status);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_check_seq_num(adi_adpd7000_fifo_seq_track_t *track, uint8_t seq_num, uint32_t *lost)
+{
+    uint8_t gap = 0;
+
+    if (track == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    if (track->valid)
+    {
+        gap = (uint8_t)(seq_num - track->seq_num - 1);
+        track->lost += gap;
+    }
+    track->valid = 1;
+    track->seq_num = seq_num;
+    if (lost != NULL)
+    {
+        *lost = gap;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_drain(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_seq_track_t *track,
+    uint8_t *data, uint32_t size, adi_adpd7000_fifo_drain_t *drain)
+{
+    return adi_adpd7000_fifo_drain_fused(device, fifo, track, data, size, 0, false, drain);
+}
+
+int32_t adi_adpd7000_fifo_plan_drain(adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_seq_track_t *track, uint16_t status,
+    uint16_t max_seq, adi_adpd7000_fifo_plan_t *plan)
+{
+    uint16_t count, remain, whole;
+
+    if ((fifo == NULL) || (plan == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (fifo->sequence_size == 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    count = status & ADPD7000_FIFO_BYTE_COUNT_MASK;
+    plan->head_discard = 0;
+    plan->seq_count = 0;
+    plan->tail_discard = 0;
+    plan->clear = status & (ADPD7000_FIFO_OFLOW_MASK | ADPD7000_FIFO_UFLOW_MASK);
+    plan->lost = 0;
+
+    /* a cut remembered from an earlier drain is gone if FIFO ran empty or holds less than it */
+    if ((track != NULL) && (track->cut_size > 0) &&
+        ((status & ADPD7000_FIFO_UFLOW_MASK) || (count < track->cut_ahead * fifo->sequence_size + track->cut_size)))
+    {
+        track->cut_size = 0;
+    }
+
+    /* cut sequence behind cut_ahead whole sequences, remain of byte count no longer tells where it is */
+    if ((track != NULL) && (track->cut_size > 0))
+    {
+        plan->seq_count = (track->cut_ahead < max_seq) ? track->cut_ahead : max_seq;
+        if (plan->seq_count < track->cut_ahead)
+        {
+            track->cut_ahead -= plan->seq_count;
+            /* overflowed again behind the cut, keep the flag until the first cut is reached */
+            plan->clear &= ~ADPD7000_FIFO_OFLOW_MASK;
+        }
+        else if (status & ADPD7000_FIFO_OFLOW_MASK)
+        {
+            /* a second cut can not be located, drop everything behind the first */
+            plan->tail_discard = count - track->cut_ahead * fifo->sequence_size;
+            plan->lost = plan->tail_discard / fifo->sequence_size + 1;
+            track->cut_size = 0;
+        }
+        else
+        {
+            plan->tail_discard = track->cut_size;
+            plan->lost = 1;
+            track->cut_size = 0;
+        }
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    remain = count % fifo->sequence_size;
+    /* underflow: host has read past the data, FIFO head is in the middle of a sequence */
+    if ((status & ADPD7000_FIFO_UFLOW_MASK) && (remain > 0))
+    {
+        plan->head_discard = remain;
+        plan->lost++;
+        count -= remain;
+        remain = 0;
+    }
+    whole = count / fifo->sequence_size;
+    plan->seq_count = (whole < max_seq) ? whole : max_seq;
+
+    /* overflow: sequence at FIFO tail was cut, everything before it must be read to reach it */
+    if ((status & ADPD7000_FIFO_OFLOW_MASK) && (remain > 0))
+    {
+        if (plan->seq_count == whole)
+        {
+            plan->tail_discard = remain;
+            plan->lost++;
+        }
+        else if (track != NULL)
+        {
+            track->cut_ahead = whole - plan->seq_count;
+            track->cut_size = remain;
+        }
+        else
+        {
+            /* nowhere to remember the cut, drop the sequences before it too */
+            plan->tail_discard = (whole - plan->seq_count) * fifo->sequence_size + remain;
+            plan->lost += whole - plan->seq_count + 1;
+        }
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_drain_fused(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_fifo_seq_track_t *track,
+    uint8_t *data, uint32_t size, uint16_t predict, bool clr_int, adi_adpd7000_fifo_drain_t *drain)
+{
+    int32_t  err;
+    uint16_t status, spec_count, seq_count, i;
+    uint32_t lost;
+    adi_adpd7000_fifo_plan_t plan;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_NULL_POINTER_RETURN(data);
+    ADPD7000_NULL_POINTER_RETURN(drain);
+    ADPD7000_INVALID_PARAM_RETURN((fifo->sequence_size == 0) || (size < fifo->sequence_size));
+
+    /* speculative read of sequences known to be there, no byte count read before it, never past a cut */
+    spec_count = predict / fifo->sequence_size;
+    if (spec_count > size / fifo->sequence_size)
+    {
+        spec_count = size / fifo->sequence_size;
+    }
+    if ((track != NULL) && (track->cut_size > 0) && (spec_count > track->cut_ahead))
+    {
+        spec_count = track->cut_ahead;
+    }
+    if (spec_count > 0)
+    {
+        err = adi_adpd7000_device_fifo_read_bytes(device, data, spec_count * fifo->sequence_size);
+        ADPD7000_ERROR_RETURN(err);
+    }
+
+    /* byte count left and error flags in one register read */
+    err = adi_adpd7000_hal_reg_read(device, REG_FIFO_STATUS_ADDR, &status);
+    ADPD7000_ERROR_RETURN(err);
+    drain->oflow = (status & ADPD7000_FIFO_OFLOW_MASK) ? 1 : 0;
+    drain->uflow = (status & ADPD7000_FIFO_UFLOW_MASK) ? 1 : 0;
+    drain->spec_miss = 0;
+    drain->discard_size = 0;
+    drain->lost = 0;
+
+    /* prediction was wrong, speculative read ran past the data and can not be trusted */
+    if (drain->uflow && (spec_count > 0))
+    {
+        drain->spec_miss = 1;
+        drain->discard_size = spec_count * fifo->sequence_size;
+        drain->lost += spec_count;
+        spec_count = 0;
+    }
+    else if ((track != NULL) && (track->cut_size > 0))
+    {
+        track->cut_ahead -= spec_count;
+    }
+
+    err = adi_adpd7000_fifo_plan_drain(fifo, track, status, (uint16_t)(size / fifo->sequence_size - spec_count), &plan);
+    ADPD7000_ERROR_RETURN(err);
+    if (plan.head_discard > 0)
+    {
+        err = adi_adpd7000_fifo_discard_bytes(device, plan.head_discard);
+        ADPD7000_ERROR_RETURN(err);
+    }
+    /* follow up read of sequences beyond prediction */
+    if (plan.seq_count > 0)
+    {
+        err = adi_adpd7000_device_fifo_read_bytes(device, data + spec_count * fifo->sequence_size, plan.seq_count * fifo->sequence_size);
+        ADPD7000_ERROR_RETURN(err);
+    }
+    if (plan.tail_discard > 0)
+    {
+        err = adi_adpd7000_fifo_discard_bytes(device, plan.tail_discard);
+        ADPD7000_ERROR_RETURN(err);
+    }
+    seq_count = spec_count + plan.seq_count;
+    drain->seq_count = seq_count;
+    drain->discard_size += plan.head_discard + plan.tail_discard;
+    drain->lost += plan.lost;
+
+    /* error flags and threshold interrupt are write 1 to clear in the same register, one write */
+    status = plan.clear;
+    if (clr_int)
+    {
+        status |= ADPD7000_FIFO_TH_MASK;
+    }
+    if (status != 0)
+    {
+        err = adi_adpd7000_hal_reg_write(device, REG_FIFO_STATUS_ADDR, status);
+        ADPD7000_ERROR_RETURN(err);
+    }
+
+    if ((track != NULL) && fifo->seq_num_en)
+    {
+        drain->lost = 0;
+        for (i = 0; i < seq_count; i++)
+        {
+            err = adi_adpd7000_fifo_check_seq_num(track, data[(i + 1) * fifo->sequence_size - fifo->status_size], &lost);
+            ADPD7000_ERROR_RETURN(err);
+            drain->lost += lost;
+        }
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_get_column_sizes(adi_adpd7000_fifo_config_t *fifo, uint8_t *sizes, uint16_t capacity, uint16_t *num)
+{
+    uint16_t i, j, n = 0;
+    adi_adpd7000_ppg_fifo_config_t *ppg;
+
+    if ((fifo == NULL) || (sizes == NULL) || (num == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((fifo->ecg_over_sample > ADPD7000_ECG_MAX_OVER_SAMPLE) || (fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT) || (fifo->bioz_slot > ADPD7000_BIOZ_MAX_SLOT))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    /* count first, nothing is written if the layout does not fit */
+    n = fifo->ecg_slot * fifo->ecg_over_sample + 2 * fifo->bioz_slot + fifo->seq_num_en + fifo->stat_lev0_en + fifo->stat_lev1_en +
+        fifo->stat_levx_en;
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        ppg = &fifo->ppg_fifo[i];
+        n += (ppg->ppg_chl2_en + 1) * ((ppg->signal_size > 0) + (ppg->dark_size > 0) + (ppg->lit_size > 0));
+    }
+    if (n > capacity)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+    n = 0;
+
+    for (i = 0; i < fifo->ecg_slot * fifo->ecg_over_sample; i++)
+    {
+        sizes[n++] = fifo->ecg_size;
+    }
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        ppg = &fifo->ppg_fifo[i];
+        for (j = 0; j <= ppg->ppg_chl2_en; j++)
+        {
+            if (ppg->signal_size > 0)
+                sizes[n++] = ppg->signal_size;
+            if (ppg->dark_size > 0)
+                sizes[n++] = ppg->dark_size;
+            if (ppg->lit_size > 0)
+                sizes[n++] = ppg->lit_size;
+        }
+    }
+    for (i = 0; i < fifo->bioz_slot; i++)
+    {
+        sizes[n++] = 3;
+        sizes[n++] = 3;
+    }
+    if (fifo->seq_num_en)
+        sizes[n++] = ADPD7000_SEQ_NUM_SIZE;
+    if (fifo->stat_lev0_en)
+        sizes[n++] = ADPD7000_STAT_LEV0_SIZE;
+    if (fifo->stat_lev1_en)
+        sizes[n++] = ADPD7000_STAT_LEV1_SIZE;
+    if (fifo->stat_levx_en)
+        sizes[n++] = ADPD7000_STAT_LEVX_SIZE;
+    *num = n;
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -200,4 +200,66 @@ int32_t adi_adpd7000_hal_fifo_read_bytes(adi_adpd7000_device_t *device, uint32_t
     return API_ADPD7000_ERROR_OK;
 }
 
+int32_t adi_adpd7000_hal_reg_read_block(adi_adpd7000_device_t *device, uint32_t reg_addr, uint16_t *reg_data, uint32_t reg_num)
+{
+    int32_t err;
+    uint32_t i, address;
+    uint8_t wr_buf[ADPD7000_SDK_MAX_BUFSIZE] = {0};
+    uint8_t *rd_buf = (uint8_t *)reg_data;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_NULL_POINTER_RETURN(reg_data);
+    ADPD7000_INVALID_PARAM_RETURN(reg_num == 0);
+
+    /* address auto increments during a multi-byte read */
+    address = (reg_addr << 1);
+    wr_buf[0] = ((address  >> 8)  & 0xFF);  /* address [15:08] */
+    wr_buf[1] = ((address      )  & 0xFF);  /* address [07:00] */
+
+    err = device->read(device->user_data, rd_buf, reg_num * 2, wr_buf, 2);
+    ADPD7000_ERROR_RETURN(err);
+
+    /* big endian bytes to host order in place */
+    for (i = 0; i < reg_num; i++)
+    {
+        reg_data[i] = (uint16_t)((rd_buf[2 * i] << 8) + rd_buf[2 * i + 1]);
+    }
+
+    ADPD7000_LOG_REG("r@%.8x x %d", reg_addr, reg_num);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_hal_reg_write_block(adi_adpd7000_device_t *device, uint32_t reg_addr, const uint16_t *reg_data, uint32_t reg_num)
+{
+    int32_t err;
+    uint32_t i, n, address;
+    uint8_t wr_buf[ADPD7000_SDK_MAX_BUFSIZE] = {0};
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_NULL_POINTER_RETURN(reg_data);
+    ADPD7000_INVALID_PARAM_RETURN(reg_num == 0);
+
+    /* address auto increments during a multi-byte write, burst is limited by the control port buffer */
+    while (reg_num > 0)
+    {
+        n = (reg_num < (ADPD7000_SDK_MAX_BUFSIZE - 2) / 2) ? reg_num : ((ADPD7000_SDK_MAX_BUFSIZE - 2) / 2);
+        address = (reg_addr << 1) + 1;
+        wr_buf[0] = ((address  >> 8)  & 0xFF);  /* address [15:08] */
+        wr_buf[1] = ((address      )  & 0xFF);  /* address [07:00] */
+        for (i = 0; i < n; i++)
+        {
+            wr_buf[2 + 2 * i] = ((reg_data[i] >> 8) & 0xFF);
+            wr_buf[3 + 2 * i] = ((reg_data[i]     ) & 0xFF);
+        }
+
+        err = device->write(device->user_data, wr_buf, 2 + 2 * n);
+        ADPD7000_ERROR_RETURN(err);
+        ADPD7000_LOG_REG("w@%.8x x %d", reg_addr, n);
+        reg_addr += n;
+        reg_data += n;
+        reg_num -= n;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
 /*! @} */
@@ -0,0 +1,157 @@
+/*!
+ * @brief     Frame Pool APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static adi_adpd7000_pool_block_t *adi_adpd7000_pool_get_block(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t *frame)
+{
+    /* frame is first member of block */
+    adi_adpd7000_pool_block_t *block = (adi_adpd7000_pool_block_t *)frame;
+
+    if ((block < pool->block) || (block >= pool->block + pool->block_num))
+        return NULL;
+
+    return block;
+}
+
+int32_t adi_adpd7000_frame_pool_get_block_num(adi_adpd7000_fifo_config_t *fifo, uint32_t depth, uint32_t *block_num)
+{
+    if ((fifo == NULL) || (block_num == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((fifo->sequence_size == 0) || (fifo->sequence_size > ADPD7000_FIFO_SIZE) || (depth == 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    *block_num = depth * (ADPD7000_FIFO_SIZE / fifo->sequence_size);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_frame_pool_init(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_pool_block_t *block, uint32_t block_num)
+{
+    uint32_t i;
+
+    if ((pool == NULL) || (block == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (block_num == 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    for (i = 0; i < block_num; i++)
+    {
+        block[i].ref = 0;
+        block[i].next = i + 1;
+    }
+    pool->block = block;
+    pool->block_num = block_num;
+    pool->free_head = 0;
+    pool->free_count = block_num;
+    pool->low_water = block_num;
+    pool->fail_count = 0;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_frame_pool_alloc(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t **frame)
+{
+    uint32_t head, next, count;
+
+    if ((pool == NULL) || (frame == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    /* only the allocator removes blocks, so head can not be taken and pushed back under us (no ABA) */
+    head = ADPD7000_ATOMIC_LOAD_ACQUIRE(&pool->free_head);
+    do
+    {
+        if (head == pool->block_num)
+        {
+            ADPD7000_ATOMIC_STORE_RELAXED(&pool->fail_count, pool->fail_count + 1);
+            return API_ADPD7000_ERROR_BUFFER_EMPTY;
+        }
+        next = ADPD7000_ATOMIC_LOAD_RELAXED(&pool->block[head].next);
+    } while (!ADPD7000_ATOMIC_CAS(&pool->free_head, &head, next));
+
+    count = ADPD7000_ATOMIC_FETCH_SUB(&pool->free_count, 1) - 1;
+    if (count < pool->low_water)
+    {
+        ADPD7000_ATOMIC_STORE_RELAXED(&pool->low_water, count);
+    }
+    ADPD7000_ATOMIC_STORE_RELAXED(&pool->block[head].ref, 1);
+    *frame = &pool->block[head].frame;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_frame_pool_retain(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t *frame)
+{
+    adi_adpd7000_pool_block_t *block;
+
+    if ((pool == NULL) || (frame == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    block = adi_adpd7000_pool_get_block(pool, frame);
+    if (block == NULL)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    ADPD7000_ATOMIC_FETCH_ADD(&block->ref, 1);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_frame_pool_release(adi_adpd7000_frame_pool_t *pool, adi_adpd7000_frame_t *frame)
+{
+    uint32_t index, head;
+    adi_adpd7000_pool_block_t *block;
+
+    if ((pool == NULL) || (frame == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    block = adi_adpd7000_pool_get_block(pool, frame);
+    if (block == NULL)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    if (ADPD7000_ATOMIC_FETCH_SUB(&block->ref, 1) != 1)
+        return API_ADPD7000_ERROR_OK;
+
+    /* last reference, push block on free list, count first so it never drops below list length */
+    ADPD7000_ATOMIC_FETCH_ADD(&pool->free_count, 1);
+    index = (uint32_t)(block - pool->block);
+    head = ADPD7000_ATOMIC_LOAD_RELAXED(&pool->free_head);
+    do
+    {
+        ADPD7000_ATOMIC_STORE_RELAXED(&block->next, head);
+    } while (!ADPD7000_ATOMIC_CAS(&pool->free_head, &head, index));
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_frame_pool_get_stats(adi_adpd7000_frame_pool_t *pool, uint32_t *free_count, uint32_t *low_water, uint32_t *fail_count)
+{
+    if (pool == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    if (free_count != NULL)
+    {
+        *free_count = ADPD7000_ATOMIC_LOAD_RELAXED(&pool->free_count);
+    }
+    if (low_water != NULL)
+    {
+        *low_water = ADPD7000_ATOMIC_LOAD_RELAXED(&pool->low_water);
+    }
+    if (fail_count != NULL)
+    {
+        *fail_count = ADPD7000_ATOMIC_LOAD_RELAXED(&pool->fail_count);
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -10,13 +10,11 @@
 
 /*============= I N C L U D E S ============*/
 #include "adi_adpd7000.h"
-#include "math.h"
    
 /*============= D E F I N E S ==============*/
 
 /*============= D A T A ====================*/
-uint16_t ppg_sample_count;
-adi_adpd7000_ppg_agc_run_t ppg_agc_run[12];
+static adi_adpd7000_agc_t ppg_agc;                              /*!< Engine behind adi_adpd7000_ppg_agc_process */
    
 /*============= C O D E ====================*/
 int32_t adi_adpd7000_ppg_enable_slot(adi_adpd7000_device_t *device, adi_adpd7000_ppg_slot_num_e num)
@@ -634,183 +632,70 @@ int32_t adi_adpd7000_ppg_read_struct_fifo(adi_adpd7000_device_t *device, adi_adp
     return API_ADPD7000_ERROR_OK;
 }
 
-int32_t adi_adpd7000_ppg_agc_init(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_agc_cfg_t *ppg_agc_cfg)
+int32_t adi_adpd7000_ppg_read_latest(adi_adpd7000_device_t *device, uint8_t slot_mask, adi_adpd7000_ppg_slot_data_t *signal_data, adi_adpd7000_ppg_slot_data_t *dark_data)
 {
-    int32_t err;
-    uint8_t i;
-    uint16_t data;
-    ppg_sample_count = 0;
+    int32_t  err;
+    uint8_t  i, j, first, last, slot_span;
+    uint16_t reg_num;
+    uint16_t data[(REG_DARK2_H_B_ADDR - REG_SIGNAL1_L_A_ADDR) + 1];
+    uint16_t *slot_data;
     ADPD7000_NULL_POINTER_RETURN(device);
     ADPD7000_LOG_FUNC();
-    ADPD7000_NULL_POINTER_RETURN(fifo);
-    ADPD7000_NULL_POINTER_RETURN(ppg_agc_cfg);
-    ADPD7000_INVALID_PARAM_RETURN(ppg_agc_cfg->ppg_average_sample_number == 0);
+    ADPD7000_NULL_POINTER_RETURN(signal_data);
+    ADPD7000_INVALID_PARAM_RETURN((slot_mask == 0) || (slot_mask >= (1 << ADPD7000_PPG_LATEST_SLOT)));
 
-    for (i = 0; i < fifo->ppg_slot; i++)
-    {
-        ppg_agc_run[i].ppg_data_sum = 0;
-        ppg_agc_run[i].agc_done = 0;
-        
-        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_NUM_INT_A_INFO, &data);
-        ADPD7000_ERROR_RETURN(err);
-        ppg_agc_run[i].ppg_full_scale = 16383 * data;
-        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_NUM_REPEAT_A_INFO, &data);
-        ADPD7000_ERROR_RETURN(err);
-        ppg_agc_run[i].ppg_full_scale = ppg_agc_run[i].ppg_full_scale * data;
+    /* one block covering selected slots, per slot: signal1/2 then dark1/2, L/H register pairs */
+    slot_span = REG_SIGNAL1_L_B_ADDR - REG_SIGNAL1_L_A_ADDR;
+    first = (slot_mask & 0x01) ? 0 : 1;
+    last = (slot_mask & 0x02) ? 1 : 0;
+    reg_num = (last - first) * slot_span + ((dark_data != NULL) ? slot_span : (REG_DARK1_L_A_ADDR - REG_SIGNAL1_L_A_ADDR));
+    err = adi_adpd7000_hal_reg_read_block(device, REG_SIGNAL1_L_A_ADDR + first * slot_span, data, reg_num);
+    ADPD7000_ERROR_RETURN(err);
 
-        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_TIA_GAIN_CH1_A_INFO, &data);
-        ADPD7000_ERROR_RETURN(err);
-        ppg_agc_run[i].tia_gain = data;
-        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_LED_CURRENT1_A_INFO + 8 * ppg_agc_cfg->slot[i].led_chnl, &data);
-        ADPD7000_ERROR_RETURN(err);
-        ppg_agc_run[i].led_current = data;
+    for (i = first; i <= last; i++)
+    {
+        if ((slot_mask & (1 << i)) == 0)
+            continue;
+        slot_data = data + (i - first) * slot_span;
+        for (j = 0; j < 2; j++)
+        {
+            signal_data[i].chnl[j] = ((uint32_t)slot_data[2 * j + 1] << 16) | slot_data[2 * j];
+            if (dark_data != NULL)
+            {
+                dark_data[i].chnl[j] = ((uint32_t)slot_data[2 * j + 5] << 16) | slot_data[2 * j + 4];
+            }
+        }
     }
-    
+
     return API_ADPD7000_ERROR_OK;
 }
 
+int32_t adi_adpd7000_ppg_agc_init(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_agc_cfg_t *ppg_agc_cfg)
+{
+    return adi_adpd7000_agc_init(device, &ppg_agc, fifo, ppg_agc_cfg);
+}
+
 int32_t adi_adpd7000_ppg_agc_process(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, adi_adpd7000_ppg_agc_cfg_t *ppg_agc_cfg, uint32_t *signal_data)
 {
-    int32_t err;
-    uint8_t i;
-    uint32_t data;
-    float step;
-    float ppg_data_avg, ppg_chnl_current;
+    uint8_t i, j;
+    adi_adpd7000_ppg_slot_data_t data[ADPD7000_PPG_MAX_SLOT];
     ADPD7000_NULL_POINTER_RETURN(device);
     ADPD7000_LOG_FUNC();
     ADPD7000_NULL_POINTER_RETURN(fifo);
     ADPD7000_NULL_POINTER_RETURN(ppg_agc_cfg);
     ADPD7000_NULL_POINTER_RETURN(signal_data);
-    
-    ppg_sample_count++;
-    if (ppg_sample_count <= ppg_agc_cfg->ppg_skip_sample_number)  
-    {
-        return API_ADPD7000_ERROR_OK;
-    }
-    if (ppg_sample_count <= (ppg_agc_cfg->ppg_skip_sample_number + ppg_agc_cfg->ppg_average_sample_number))
-    {
-        for (i = 0; i < fifo->ppg_slot; i++)
-        {
-            if (fifo->ppg_fifo[i].ppg_chl2_en == 0)
-            {
-                ppg_agc_run[i].ppg_data_sum += *signal_data++;
-            }
-            else
-            {
-                if (ppg_agc_cfg->slot[i].tia_chnl == 0)
-                {
-                    ppg_agc_run[i].ppg_data_sum += *signal_data++;
-                    data = *signal_data++;
-                }
-                else if (ppg_agc_cfg->slot[i].tia_chnl == 1)
-                {
-                    data = *signal_data++;
-                    ppg_agc_run[i].ppg_data_sum += *signal_data++;
-                }
-            }
-        }
-        data = data;
-        return API_ADPD7000_ERROR_OK;
-    }
-    
+    ADPD7000_INVALID_PARAM_RETURN(fifo->ppg_slot != ppg_agc.slot_num);
+
+    /* signal_data packs channel 2 only for the slots that have it enabled */
     for (i = 0; i < fifo->ppg_slot; i++)
     {
-        if ((ppg_agc_cfg->slot[i].agc_en == 0) || (ppg_agc_run[i].agc_done == 1))
-        {
-            continue;
-        }
-        ppg_data_avg = ppg_agc_run[i].ppg_data_sum / ppg_agc_cfg->ppg_average_sample_number;
-        ppg_data_avg ++;
-        ppg_chnl_current = (float)(ppg_agc_run[i].led_current * ppg_agc_run[i].ppg_full_scale * 0.5 / ppg_data_avg);
-        if (ppg_chnl_current > 127)
-        {         
-            if(ppg_agc_run[i].tia_gain > 0)
-            {
-                ppg_agc_run[i].tia_gain = ppg_agc_run[i].tia_gain - 1;
-                ppg_chnl_current = ppg_agc_run[i].led_current; 
-            }
-            else
-            {
-                ppg_chnl_current = ppg_agc_run[i].led_current + 0x10;
-                ppg_chnl_current = (ppg_chnl_current > 127) ? 127 : ppg_chnl_current;
-            }
-        }
-        else if (ppg_chnl_current < 1)
-        {
-            if(ppg_agc_run[i].tia_gain < 5)
-            {
-                ppg_agc_run[i].tia_gain = ppg_agc_run[i].tia_gain + 1;
-                ppg_chnl_current =  ppg_agc_run[i].led_current;
-            }
-            else
-            {
-                ppg_chnl_current = (ppg_agc_run[i].led_current > 0x11) ? (ppg_agc_run[i].led_current - 0x10) : 1; 
-            }
-        }
-        
-        if (ppg_agc_cfg->power_first_en == 0)    /* low tia gain */ 
-        {
-            if (fabs(ppg_agc_run[i].led_current - (uint8_t)ppg_chnl_current) > 1)
-            {
-                ppg_agc_run[i].led_current = (uint8_t)ppg_chnl_current;
-            }
-            else
-            {
-                if (ppg_agc_cfg->slot[i].agc_type == 1)
-                {
-                    ppg_agc_run[i].agc_done = 1;
-                }
-            }
-
-            if ((ppg_agc_run[i].led_current < 0x20) && (ppg_agc_run[i].tia_gain < 5))
-            {
-                ppg_agc_run[i].led_current = ppg_agc_run[i].led_current * 2;
-                ppg_agc_run[i].tia_gain = ppg_agc_run[i].tia_gain + 1;
-            }
-        }
-        else                                    /* low LED current */  
+        for (j = 0; j <= fifo->ppg_fifo[i].ppg_chl2_en; j++)
         {
-            step = fabs(ppg_chnl_current - ppg_agc_run[i].led_current) / 4;
-            if (step < 1)
-            {
-                step = 1;
-            } 
-            if (ppg_agc_run[i].led_current > ((uint8_t)ppg_chnl_current + 1))
-            {
-                ppg_agc_run[i].led_current -= (uint8_t)step;
-            }
-            else if (ppg_agc_run[i].led_current < ((uint8_t)ppg_chnl_current - 1))
-            {
-                ppg_agc_run[i].led_current += (uint8_t)step;
-            }
-            if ((ppg_agc_run[i].led_current > 0x10) && (ppg_agc_run[i].tia_gain > 2))
-            {
-                ppg_agc_run[i].led_current = ppg_agc_run[i].led_current / 2;
-                ppg_agc_run[i].tia_gain = ppg_agc_run[i].tia_gain - 1;
-            }
+            data[i].chnl[j] = *signal_data++;
         }
     }
+    ppg_agc.cfg = *ppg_agc_cfg;
 
-    adi_adpd7000_device_enable_slot_operation_mode_go(device, false);
-    for (i = 0; i < fifo->ppg_slot; i++)
-    {      
-        if (ppg_agc_cfg->slot[i].agc_en == 1)
-        {
-            err = adi_adpd7000_ppg_tia_set_gain_res(device, i, ppg_agc_cfg->slot[i].tia_chnl, ppg_agc_run[i].tia_gain);
-            ADPD7000_ERROR_RETURN(err);
-            err = adi_adpd7000_ppg_led_set_current(device, i, ppg_agc_cfg->slot[i].led_chnl, ppg_agc_run[i].led_current);
-            ADPD7000_ERROR_RETURN(err);
-        }
-    }
-    adi_adpd7000_device_clr_fifo(device);
-    adi_adpd7000_device_enable_slot_operation_mode_go(device, true);
-    
-    ppg_sample_count = 0;
-    for (i = 0; i < fifo->ppg_slot; i++)
-    {
-        ppg_agc_run[i].ppg_data_sum = 0;;
-    }
-    
-    return err;
+    return adi_adpd7000_agc_process(device, &ppg_agc, data);
 }
 /*! @} */
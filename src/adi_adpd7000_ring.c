@@ -0,0 +1,155 @@
+/*!
+ * @brief     Lock-free Ring APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+int32_t adi_adpd7000_ring_init(adi_adpd7000_ring_t *ring, void *buf, uint32_t elem_size, uint32_t capacity)
+{
+    if ((ring == NULL) || (buf == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((elem_size == 0) || (capacity == 0) || ((capacity & (capacity - 1)) != 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    memset(ring, 0, sizeof(adi_adpd7000_ring_t));
+    ring->buf = (uint8_t *)buf;
+    ring->elem_size = elem_size;
+    ring->mask = capacity - 1;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_ring_reserve(adi_adpd7000_ring_t *ring, void **elem)
+{
+    uint32_t head, tail;
+
+    if ((ring == NULL) || (elem == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    head = ring->head;
+    tail = ADPD7000_ATOMIC_LOAD_ACQUIRE(&ring->tail);
+    if (head - tail > ring->mask)
+    {
+        ADPD7000_ATOMIC_STORE_RELAXED(&ring->drop_count, ring->drop_count + 1);
+        return API_ADPD7000_ERROR_BUFFER_FULL;
+    }
+    *elem = ring->buf + (head & ring->mask) * ring->elem_size;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_ring_commit(adi_adpd7000_ring_t *ring)
+{
+    uint32_t head, count;
+
+    if (ring == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    head = ring->head + 1;
+    count = head - ADPD7000_ATOMIC_LOAD_RELAXED(&ring->tail);
+    if (count > ring->high_water)
+    {
+        ADPD7000_ATOMIC_STORE_RELAXED(&ring->high_water, count);
+    }
+    ADPD7000_ATOMIC_STORE_RELEASE(&ring->head, head);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_ring_push(adi_adpd7000_ring_t *ring, const void *elem)
+{
+    int32_t err;
+    void    *slot;
+
+    if (elem == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    err = adi_adpd7000_ring_reserve(ring, &slot);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    memcpy(slot, elem, ring->elem_size);
+
+    return adi_adpd7000_ring_commit(ring);
+}
+
+int32_t adi_adpd7000_ring_peek(adi_adpd7000_ring_t *ring, void **elem)
+{
+    uint32_t head, tail;
+
+    if ((ring == NULL) || (elem == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    tail = ring->tail;
+    head = ADPD7000_ATOMIC_LOAD_ACQUIRE(&ring->head);
+    if (head == tail)
+        return API_ADPD7000_ERROR_BUFFER_EMPTY;
+    *elem = ring->buf + (tail & ring->mask) * ring->elem_size;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_ring_release(adi_adpd7000_ring_t *ring)
+{
+    if (ring == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    ADPD7000_ATOMIC_STORE_RELEASE(&ring->tail, ring->tail + 1);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_ring_pop(adi_adpd7000_ring_t *ring, void *elem)
+{
+    int32_t err;
+    void    *slot;
+
+    if (elem == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    err = adi_adpd7000_ring_peek(ring, &slot);
+    if (err != API_ADPD7000_ERROR_OK)
+        return err;
+    memcpy(elem, slot, ring->elem_size);
+
+    return adi_adpd7000_ring_release(ring);
+}
+
+int32_t adi_adpd7000_ring_get_stats(adi_adpd7000_ring_t *ring, uint32_t *count, uint32_t *high_water, uint32_t *drop_count)
+{
+    if (ring == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    if (count != NULL)
+    {
+        *count = ADPD7000_ATOMIC_LOAD_ACQUIRE(&ring->head) - ADPD7000_ATOMIC_LOAD_ACQUIRE(&ring->tail);
+    }
+    if (high_water != NULL)
+    {
+        *high_water = ADPD7000_ATOMIC_LOAD_RELAXED(&ring->high_water);
+    }
+    if (drop_count != NULL)
+    {
+        *drop_count = ADPD7000_ATOMIC_LOAD_RELAXED(&ring->drop_count);
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+void adi_adpd7000_ring_frame_cb(void *user_data, const adi_adpd7000_frame_t *frame)
+{
+    adi_adpd7000_ring_push((adi_adpd7000_ring_t *)user_data, frame);
+}
+/*! @} */
@@ -0,0 +1,157 @@
+/*!
+ * @brief     Drain Scheduler APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_SCHED_OUTLIER_RATIO   (0.5)                   /*!< Rate sample this far off fill rate is an outlier */
+#define ADPD7000_SCHED_OUTLIER_NUM     (2)                     /*!< Consecutive outliers taken as a rate change */
+#define ADPD7000_SCHED_WINDOW_BATCH    (2)                     /*!< Rate sample window, unit: batch */
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static void adi_adpd7000_sched_resync(adi_adpd7000_sched_t *sched, uint16_t count, int64_t host_us)
+{
+    sched->last_us = host_us;
+    sched->last_count = count;
+    sched->window_us = host_us;
+    sched->window_size = 0;
+    sched->valid = 1;
+}
+
+int32_t adi_adpd7000_sched_init(adi_adpd7000_sched_t *sched, adi_adpd7000_fifo_config_t *fifo, uint32_t slot_freq, uint16_t batch, double alpha)
+{
+    if ((sched == NULL) || (fifo == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    /* one sequence of headroom, adi_adpd7000_sched_update drops counts within a sequence of full */
+    if ((fifo->sequence_size == 0) || (batch == 0) || ((batch + 1) * fifo->sequence_size > ADPD7000_FIFO_SIZE) ||
+        (alpha <= 0) || (alpha > 1))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    sched->sequence_size = fifo->sequence_size;
+    sched->batch_size = batch * fifo->sequence_size;
+    sched->alpha = alpha;
+    sched->reset_count = 0;
+
+    return adi_adpd7000_sched_set_slot_freq(sched, slot_freq);
+}
+
+int32_t adi_adpd7000_sched_set_slot_freq(adi_adpd7000_sched_t *sched, uint32_t slot_freq)
+{
+    if (sched == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (slot_freq == 0)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    /* configured rate is the prior, learned rate restarts from it */
+    sched->rate = (double)slot_freq * sched->sequence_size / 1000000.0;
+    sched->outlier = 0;
+    sched->valid = 0;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_sched_update(adi_adpd7000_sched_t *sched, uint16_t count, int64_t host_us)
+{
+    double sample, diff;
+    uint32_t window;
+
+    if (sched == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    /* FIFO cleared or read behind scheduler, or near full and may have overflowed, no rate sample */
+    if ((!sched->valid) || (host_us <= sched->last_us) || (count < sched->last_count) ||
+        (count + sched->sequence_size > ADPD7000_FIFO_SIZE))
+    {
+        adi_adpd7000_sched_resync(sched, count, host_us);
+        return API_ADPD7000_ERROR_OK;
+    }
+
+    sched->window_size += count - sched->last_count;
+    sched->last_us = host_us;
+    sched->last_count = count;
+
+    /* count moves in whole sequences, sample over a few batches to keep quantization error low */
+    window = ADPD7000_SCHED_WINDOW_BATCH * sched->batch_size;
+    if ((sched->window_size < window) && ((host_us - sched->window_us) * sched->rate < window))
+        return API_ADPD7000_ERROR_OK;
+
+    sample = sched->window_size / (double)(host_us - sched->window_us);
+    sched->window_us = host_us;
+    sched->window_size = 0;
+    diff = sample - sched->rate;
+    if ((diff > sched->rate * ADPD7000_SCHED_OUTLIER_RATIO) || (-diff > sched->rate * ADPD7000_SCHED_OUTLIER_RATIO))
+    {
+        /* a single outlier is a late wake up, persistent ones a rate change */
+        if (++sched->outlier >= ADPD7000_SCHED_OUTLIER_NUM)
+        {
+            sched->rate = sample;
+            sched->outlier = 0;
+            sched->reset_count++;
+        }
+    }
+    else
+    {
+        /* exponential average tracks oscillator drift */
+        sched->rate += sched->alpha * diff;
+        sched->outlier = 0;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_sched_poll(adi_adpd7000_device_t *device, adi_adpd7000_sched_t *sched, int64_t host_us, uint16_t *count)
+{
+    int32_t  err;
+    uint16_t data;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(sched);
+
+    err = adi_adpd7000_device_get_fifo_count(device, &data);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_sched_update(sched, data, host_us);
+    ADPD7000_ERROR_RETURN(err);
+    if (count != NULL)
+    {
+        *count = data;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_sched_consume(adi_adpd7000_sched_t *sched, uint32_t size)
+{
+    if (sched == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    sched->last_count = (size < sched->last_count) ? (sched->last_count - size) : 0;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_sched_get_deadline(adi_adpd7000_sched_t *sched, int64_t *deadline_us)
+{
+    uint32_t need;
+
+    if ((sched == NULL) || (deadline_us == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((!sched->valid) || (sched->rate <= 0))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    need = (sched->last_count < sched->batch_size) ? (sched->batch_size - sched->last_count) : 0;
+    /* round up, waking early would find the batch incomplete */
+    *deadline_us = sched->last_us + (int64_t)(need / sched->rate + 0.999999);
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
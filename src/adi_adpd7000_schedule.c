@@ -0,0 +1,171 @@
+/*!
+ * @brief     Sequence Schedule APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_SCHEDULE_OFFSET_UNIT   (64)                    /*!< Timeslot offset unit, unit: system clock cycle */
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static int64_t adi_adpd7000_schedule_round(double time_us)
+{
+    return (int64_t)((time_us >= 0) ? (time_us + 0.5) : (time_us - 0.5));
+}
+
+int32_t adi_adpd7000_schedule_init(adi_adpd7000_schedule_t *schedule, adi_adpd7000_fifo_config_t *fifo, double seq_period,
+    const adi_adpd7000_schedule_slot_t *ppg, const adi_adpd7000_schedule_slot_t *bioz)
+{
+    uint8_t  i;
+    double   start = 0, period;
+    const adi_adpd7000_schedule_slot_t *slot;
+
+    if ((schedule == NULL) || (fifo == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (((ppg == NULL) && (fifo->ppg_slot > 0)) || ((bioz == NULL) && (fifo->bioz_slot > 0)))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((seq_period <= 0) || (fifo->ecg_over_sample > ADPD7000_ECG_MAX_OVER_SAMPLE) || (fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT) ||
+        (fifo->bioz_slot > ADPD7000_BIOZ_MAX_SLOT))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    schedule->seq_period = seq_period;
+    schedule->ecg_num = fifo->ecg_slot ? fifo->ecg_over_sample : 0;
+    /* ECG oversamples are evenly spread over the sequence */
+    schedule->ecg_step = (schedule->ecg_num > 0) ? (seq_period / schedule->ecg_num) : 0;
+    schedule->ppg_slot_num = fifo->ppg_slot;
+    schedule->bioz_num = fifo->bioz_slot;
+    schedule->seq_index = 0;
+
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        slot = &ppg[i];
+        if (slot->offset > 0)
+        {
+            start = slot->offset;
+        }
+        period = (slot->pulse_period > 0) ? slot->pulse_period : (slot->led_offset + slot->led_width);
+        /* integrated over the whole pulse train, its middle is the effective sample time */
+        schedule->ppg[i] = start + slot->led_offset + slot->led_width / 2.0;
+        if (slot->pulse_num > 1)
+        {
+            schedule->ppg[i] += (slot->pulse_num - 1) * period / 2;
+        }
+        schedule->ppg_decimate[i] = (slot->decimate > 1) ? slot->decimate : 1;
+        start += slot->led_offset + slot->pulse_num * period;
+    }
+    for (i = 0; i < fifo->bioz_slot; i++)
+    {
+        slot = &bioz[i];
+        if (slot->offset > 0)
+        {
+            start = slot->offset;
+        }
+        schedule->bioz[i] = start;
+        schedule->bioz_decimate[i] = (slot->decimate > 1) ? slot->decimate : 1;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_schedule_read(adi_adpd7000_device_t *device, adi_adpd7000_fifo_config_t *fifo, uint32_t sys_clk,
+    adi_adpd7000_schedule_t *schedule)
+{
+    int32_t  err;
+    uint8_t  i;
+    uint16_t data, data_h, num_int;
+    double   unit;
+    adi_adpd7000_schedule_slot_t ppg[ADPD7000_PPG_MAX_SLOT];
+    adi_adpd7000_schedule_slot_t bioz[ADPD7000_BIOZ_MAX_SLOT];
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(fifo);
+    ADPD7000_NULL_POINTER_RETURN(schedule);
+    ADPD7000_INVALID_PARAM_RETURN(sys_clk == 0);
+    ADPD7000_INVALID_PARAM_RETURN((fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT) || (fifo->bioz_slot > ADPD7000_BIOZ_MAX_SLOT));
+
+    unit = ADPD7000_SCHEDULE_OFFSET_UNIT * 1000000.0 / sys_clk;
+    for (i = 0; i < fifo->ppg_slot; i++)
+    {
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_TIMESLOT_OFFSET_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        ppg[i].offset = (uint32_t)(data * unit + 0.5);
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_LED_OFFSET_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        ppg[i].led_offset = data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_LED_WIDTH_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        ppg[i].led_width = data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_MIN_PERIOD_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        ppg[i].pulse_period = data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_NUM_INT_A_INFO, &num_int);
+        ADPD7000_ERROR_RETURN(err);
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_NUM_REPEAT_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        ppg[i].pulse_num = num_int * data;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_TIME_SLOT_SPAN * i + BF_SUBSAMPLE_RATIO_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        ppg[i].decimate = (uint8_t)data;
+    }
+    for (i = 0; i < fifo->bioz_slot; i++)
+    {
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_BIOZ_SLOT_SPAN * i + BF_BIOZ_TIMESLOT_OFFSET_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        bioz[i].offset = (uint32_t)(data * unit + 0.5);
+        bioz[i].led_offset = 0;
+        bioz[i].led_width = 0;
+        bioz[i].pulse_period = 0;
+        bioz[i].pulse_num = 0;
+        err = adi_adpd7000_hal_bf_read(device, ADPD7000_BIOZ_SLOT_SPAN * i + BF_BIOZ_SUBSAMPLE_RATIO_A_INFO, &data);
+        ADPD7000_ERROR_RETURN(err);
+        bioz[i].decimate = (uint8_t)data;
+    }
+
+    err = adi_adpd7000_hal_bf_read(device, BF_TIMESLOT_PERIOD_L_INFO, &data);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_hal_bf_read(device, BF_TIMESLOT_PERIOD_H_INFO, &data_h);
+    ADPD7000_ERROR_RETURN(err);
+
+    return adi_adpd7000_schedule_init(schedule, fifo, (((uint32_t)data_h << 16) | data) * 1000000.0 / sys_clk, ppg, bioz);
+}
+
+int32_t adi_adpd7000_schedule_stamp_frame(adi_adpd7000_schedule_t *schedule, const adi_adpd7000_frame_t *frame, int64_t seq_us,
+    adi_adpd7000_frame_time_t *time)
+{
+    uint8_t i;
+    double  phase;
+
+    if ((schedule == NULL) || (frame == NULL) || (time == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((frame->ecg_num > schedule->ecg_num) || (frame->ppg_slot_num > schedule->ppg_slot_num) || (frame->bioz_num > schedule->bioz_num))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    for (i = 0; i < frame->ecg_num; i++)
+    {
+        time->ecg[i] = seq_us + adi_adpd7000_schedule_round(i * schedule->ecg_step);
+    }
+    /* subsampled slot runs on every decimate-th sequence from go, its value is from the last run */
+    for (i = 0; i < frame->ppg_slot_num; i++)
+    {
+        phase = (double)(schedule->seq_index % schedule->ppg_decimate[i]);
+        time->ppg[i] = seq_us + adi_adpd7000_schedule_round(schedule->ppg[i] - phase * schedule->seq_period);
+    }
+    for (i = 0; i < frame->bioz_num; i++)
+    {
+        phase = (double)(schedule->seq_index % schedule->bioz_decimate[i]);
+        time->bioz[i] = seq_us + adi_adpd7000_schedule_round(schedule->bioz[i] - phase * schedule->seq_period);
+    }
+    schedule->seq_index++;
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -0,0 +1,258 @@
+/*!
+ * @brief     Interrupt Driven Stream APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static void adi_adpd7000_stream_deliver(adi_adpd7000_stream_t *stream, adi_adpd7000_frame_t *frame)
+{
+    if (stream->frame_cb != NULL)
+    {
+        stream->frame_cb(stream->user_data, frame);
+    }
+    if ((stream->ecg_cb != NULL) && (frame->ecg_num > 0))
+    {
+        stream->ecg_cb(stream->user_data, frame->ecg_data, frame->ecg_status, frame->ecg_num);
+    }
+    if ((stream->ppg_cb != NULL) && (frame->ppg_slot_num > 0))
+    {
+        stream->ppg_cb(stream->user_data, frame->ppg_signal, frame->ppg_dark, frame->ppg_lit, frame->ppg_slot_num);
+    }
+    if ((stream->bioz_cb != NULL) && (frame->bioz_num > 0))
+    {
+        stream->bioz_cb(stream->user_data, frame->bioz, frame->bioz_num);
+    }
+    if ((stream->pool_cb != NULL) && (frame != &stream->frame))
+    {
+        stream->pool_cb(stream->user_data, frame);
+    }
+}
+
+static int32_t adi_adpd7000_stream_load_predict(adi_adpd7000_stream_t *stream)
+{
+    int32_t  err;
+    uint16_t threshold;
+    adi_adpd7000_device_t *device = stream->device;
+
+    /* interrupt fires once byte count exceeds threshold */
+    err = adi_adpd7000_hal_bf_read(device, BF_FIFO_TH_INFO, &threshold);
+    ADPD7000_ERROR_RETURN(err);
+    stream->predict = threshold + 1;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_init(adi_adpd7000_stream_t *stream, adi_adpd7000_device_t *device, adi_adpd7000_interrupt_type_e int_type)
+{
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(stream);
+    ADPD7000_INVALID_PARAM_RETURN(int_type > API_ADPD7000_INTERRUPT_Y);
+
+    memset(stream, 0, sizeof(adi_adpd7000_stream_t));
+    stream->device = device;
+    stream->int_type = int_type;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_set_callbacks(adi_adpd7000_stream_t *stream, void *user_data, adi_adpd7000_stream_frame_cb frame_cb,
+    adi_adpd7000_stream_ecg_cb ecg_cb, adi_adpd7000_stream_ppg_cb ppg_cb, adi_adpd7000_stream_bioz_cb bioz_cb)
+{
+    if (stream == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    stream->user_data = user_data;
+    stream->frame_cb = frame_cb;
+    stream->ecg_cb = ecg_cb;
+    stream->ppg_cb = ppg_cb;
+    stream->bioz_cb = bioz_cb;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_set_pool(adi_adpd7000_stream_t *stream, adi_adpd7000_frame_pool_t *pool, adi_adpd7000_stream_pool_cb pool_cb)
+{
+    if (stream == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    stream->pool = pool;
+    stream->pool_cb = pool_cb;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_start(adi_adpd7000_stream_t *stream)
+{
+    int32_t err;
+    uint32_t block_num;
+    adi_adpd7000_device_t *device;
+
+    if (stream == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    device = stream->device;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+
+    err = adi_adpd7000_device_get_sequence_fifo_config(device, &stream->fifo);
+    ADPD7000_ERROR_RETURN(err);
+    ADPD7000_INVALID_PARAM_RETURN((stream->fifo.sequence_size == 0) || (stream->fifo.sequence_size > ADPD7000_FIFO_SIZE));
+    if (stream->pool != NULL)
+    {
+        err = adi_adpd7000_frame_pool_get_block_num(&stream->fifo, 1, &block_num);
+        ADPD7000_ERROR_RETURN(err);
+        ADPD7000_INVALID_PARAM_RETURN(stream->pool->block_num < block_num);
+    }
+    memset(&stream->track, 0, sizeof(adi_adpd7000_fifo_seq_track_t));
+    err = adi_adpd7000_stream_load_predict(stream);
+    ADPD7000_ERROR_RETURN(err);
+
+    err = adi_adpd7000_device_clr_fifo(device);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_device_enable_fifo_thres_interrupt(device, stream->int_type, true);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_device_enable_slot_operation_mode_go(device, true);
+    ADPD7000_ERROR_RETURN(err);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_stop(adi_adpd7000_stream_t *stream)
+{
+    int32_t err;
+    adi_adpd7000_device_t *device;
+
+    if (stream == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    device = stream->device;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+
+    err = adi_adpd7000_device_enable_slot_operation_mode_go(device, false);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_device_enable_fifo_thres_interrupt(device, stream->int_type, false);
+    ADPD7000_ERROR_RETURN(err);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_update_fifo_threshold(adi_adpd7000_stream_t *stream, adi_adpd7000_fifo_tune_t *tune)
+{
+    int32_t err;
+    uint32_t block_num;
+    adi_adpd7000_device_t *device;
+
+    if (stream == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    device = stream->device;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+
+    err = adi_adpd7000_device_update_fifo_threshold(device, tune, &stream->fifo);
+    ADPD7000_ERROR_RETURN(err);
+    ADPD7000_INVALID_PARAM_RETURN((stream->fifo.sequence_size == 0) || (stream->fifo.sequence_size > ADPD7000_FIFO_SIZE));
+    if (stream->pool != NULL)
+    {
+        err = adi_adpd7000_frame_pool_get_block_num(&stream->fifo, 1, &block_num);
+        ADPD7000_ERROR_RETURN(err);
+        ADPD7000_INVALID_PARAM_RETURN(stream->pool->block_num < block_num);
+    }
+    /* speculative read of the next interrupt must not exceed the new threshold */
+    return adi_adpd7000_stream_load_predict(stream);
+}
+
+int32_t adi_adpd7000_stream_irq_handler(adi_adpd7000_stream_t *stream)
+{
+    int32_t  err;
+    uint16_t i;
+    uint16_t predict;
+    uint32_t seq_total = 0;
+    adi_adpd7000_fifo_drain_t drain;
+    adi_adpd7000_frame_t *frame;
+    adi_adpd7000_device_t *device;
+
+    if (stream == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    device = stream->device;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+
+    stream->stats.irq_count++;
+    predict = stream->predict;
+    do
+    {
+        err = adi_adpd7000_fifo_drain_fused(device, &stream->fifo, &stream->track, stream->buf, sizeof(stream->buf), predict, true, &drain);
+        if (err != API_ADPD7000_ERROR_OK)
+        {
+            stream->stats.error_count++;
+            return err;
+        }
+        stream->stats.byte_count += drain.seq_count * stream->fifo.sequence_size + drain.discard_size;
+        stream->stats.oflow_count += drain.oflow;
+        stream->stats.uflow_count += drain.uflow;
+        stream->stats.lost_count += drain.lost;
+        stream->stats.discard_count += drain.discard_size;
+        stream->stats.spec_miss_count += drain.spec_miss;
+        /* only the first read after the interrupt is known to find threshold bytes */
+        predict = 0;
+
+        for (i = 0; i < drain.seq_count; i++)
+        {
+            frame = &stream->frame;
+            if ((stream->pool != NULL) &&
+                (adi_adpd7000_frame_pool_alloc(stream->pool, &frame) != API_ADPD7000_ERROR_OK))
+            {
+                stream->stats.pool_drop_count++;
+            }
+            err = adi_adpd7000_fifo_decode_frame(&stream->fifo, stream->buf + i * stream->fifo.sequence_size, frame);
+            if (err == API_ADPD7000_ERROR_OK)
+            {
+                adi_adpd7000_stream_deliver(stream, frame);
+            }
+            /* drop stream reference, frame stays out of pool if retained by consumer */
+            if (frame != &stream->frame)
+            {
+                adi_adpd7000_frame_pool_release(stream->pool, frame);
+            }
+            ADPD7000_ERROR_RETURN(err);
+        }
+        seq_total += drain.seq_count;
+    /* buffer full, more sequences may be waiting */
+    } while (drain.seq_count == sizeof(stream->buf) / stream->fifo.sequence_size);
+
+    stream->stats.seq_count += seq_total;
+    if (seq_total == 0)
+    {
+        stream->stats.empty_count++;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_stream_get_stats(adi_adpd7000_stream_t *stream, adi_adpd7000_stream_stats_t *stats, bool reset)
+{
+    if ((stream == NULL) || (stats == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    *stats = stream->stats;
+    if (reset)
+    {
+        memset(&stream->stats, 0, sizeof(adi_adpd7000_stream_stats_t));
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
@@ -0,0 +1,175 @@
+/*!
+ * @brief     Timestamp APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+int32_t adi_adpd7000_timestamp_config(adi_adpd7000_device_t *device, uint8_t gpio, bool always_en, bool inv)
+{
+    int32_t  err;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_INVALID_PARAM_RETURN(gpio > 3);
+
+    err = adi_adpd7000_hal_bf_write(device, BF_TIMESTAMP_GPIO_INFO, gpio);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_hal_bf_write(device, BF_TIMESTAMP_ALWAYS_EN_INFO, always_en ? 1 : 0);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_hal_bf_write(device, BF_TIMESTAMP_INV_INFO, inv ? 1 : 0);
+    ADPD7000_ERROR_RETURN(err);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_enable_capture(adi_adpd7000_device_t *device, bool enable)
+{
+    int32_t  err;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+
+    err = adi_adpd7000_hal_bf_write(device, BF_CAPTURE_TIMESTAMP_INFO, enable ? 1 : 0);
+    ADPD7000_ERROR_RETURN(err);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_read(adi_adpd7000_device_t *device, uint32_t *stamp, uint16_t *delta)
+{
+    int32_t  err;
+    uint16_t data_l, data_h;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(stamp);
+
+    err = adi_adpd7000_hal_reg_read(device, REG_STAMP_L_ADDR, &data_l);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_hal_reg_read(device, REG_STAMP_H_ADDR, &data_h);
+    ADPD7000_ERROR_RETURN(err);
+    *stamp = ((uint32_t)data_h << 16) | data_l;
+    if (delta != NULL)
+    {
+        err = adi_adpd7000_hal_reg_read(device, REG_STAMPDELTA_ADDR, delta);
+        ADPD7000_ERROR_RETURN(err);
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_sync_init(adi_adpd7000_ts_sync_t *sync, uint32_t clk_freq, double forget)
+{
+    if (sync == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((clk_freq == 0) || (forget <= 0) || (forget > 1))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    sync->clk_freq = clk_freq;
+    sync->forget = forget;
+    sync->valid = 0;
+    sync->stamp = 0;
+    sync->ext_stamp = 0;
+    sync->host_base = 0;
+    sync->weight = 0;
+    sync->mean_x = 0;
+    sync->mean_y = 0;
+    sync->cov_xx = 0;
+    sync->cov_xy = 0;
+    sync->slope = 1000000.0 / clk_freq;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_sync_update(adi_adpd7000_ts_sync_t *sync, uint32_t stamp, int64_t host_us)
+{
+    double x, y, dx;
+
+    if (sync == NULL)
+        return API_ADPD7000_ERROR_NULL_PARAM;
+
+    if (sync->valid)
+    {
+        sync->ext_stamp += (uint32_t)(stamp - sync->stamp);
+    }
+    else
+    {
+        /* fit is done relative to the first pair to keep double precision */
+        sync->ext_stamp = 0;
+        sync->host_base = host_us;
+        sync->valid = 1;
+    }
+    sync->stamp = stamp;
+
+    /* weighted Welford update, numerically stable for long runs */
+    x = (double)sync->ext_stamp;
+    y = (double)(host_us - sync->host_base);
+    sync->weight = sync->forget * sync->weight + 1;
+    dx = x - sync->mean_x;
+    sync->mean_x += dx / sync->weight;
+    sync->mean_y += (y - sync->mean_y) / sync->weight;
+    sync->cov_xx = sync->forget * sync->cov_xx + dx * (x - sync->mean_x);
+    sync->cov_xy = sync->forget * sync->cov_xy + dx * (y - sync->mean_y);
+    if (sync->cov_xx > 0)
+    {
+        sync->slope = sync->cov_xy / sync->cov_xx;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_capture(adi_adpd7000_device_t *device, adi_adpd7000_ts_sync_t *sync, int64_t host_us, uint32_t *stamp, uint16_t *delta)
+{
+    int32_t  err;
+    uint32_t data;
+    ADPD7000_NULL_POINTER_RETURN(device);
+    ADPD7000_LOG_FUNC();
+    ADPD7000_NULL_POINTER_RETURN(sync);
+
+    err = adi_adpd7000_timestamp_read(device, &data, delta);
+    ADPD7000_ERROR_RETURN(err);
+    err = adi_adpd7000_timestamp_sync_update(sync, data, host_us);
+    ADPD7000_ERROR_RETURN(err);
+    if (stamp != NULL)
+    {
+        *stamp = data;
+    }
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_to_host(adi_adpd7000_ts_sync_t *sync, uint32_t stamp, int64_t *host_us)
+{
+    double x, y;
+
+    if ((sync == NULL) || (host_us == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (!sync->valid)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    x = (double)(sync->ext_stamp + (int32_t)(stamp - sync->stamp));
+    y = sync->mean_y + sync->slope * (x - sync->mean_x);
+    *host_us = sync->host_base + (int64_t)((y >= 0) ? (y + 0.5) : (y - 0.5));
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_timestamp_get_sequence_time(adi_adpd7000_ts_sync_t *sync, uint32_t stamp, uint16_t delta, uint32_t period,
+    uint16_t seq_count, uint16_t index, int64_t *host_us)
+{
+    if (index >= seq_count)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    /* last drained sequence started delta counts before capture, older ones one period apart */
+    return adi_adpd7000_timestamp_to_host(sync, stamp - delta - (uint32_t)(seq_count - 1 - index) * period, host_us);
+}
+/*! @} */
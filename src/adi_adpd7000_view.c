@@ -0,0 +1,162 @@
+/*!
+ * @brief     FIFO View APIs Implementation
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*!
+ * @addtogroup adi_adpd7000_sdk
+ * @{
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+
+/*============= D E F I N E S ==============*/
+
+/*============= D A T A ====================*/
+
+/*============= C O D E ====================*/
+static uint32_t adi_adpd7000_view_ecg_bytes(adi_adpd7000_fifo_config_t *fifo)
+{
+    return fifo->ecg_slot ? (uint32_t)fifo->ecg_over_sample * fifo->ecg_size : 0;
+}
+
+static uint32_t adi_adpd7000_view_ppg_bytes(adi_adpd7000_fifo_config_t *fifo, uint8_t slot_num)
+{
+    uint8_t  i;
+    uint32_t n = 0;
+    adi_adpd7000_ppg_fifo_config_t *ppg;
+
+    for (i = 0; i < slot_num; i++)
+    {
+        ppg = &fifo->ppg_fifo[i];
+        n += (ppg->ppg_chl2_en + 1) * (ppg->signal_size + ppg->dark_size + ppg->lit_size);
+    }
+
+    return n;
+}
+
+static void adi_adpd7000_view_set_column(adi_adpd7000_fifo_view_t *view, uint32_t offset, uint8_t per_seq, uint8_t step, uint8_t size,
+    adi_adpd7000_column_view_t *column)
+{
+    column->data = view->data + offset;
+    column->sequence_size = view->fifo->sequence_size;
+    column->len = view->seq_num * per_seq;
+    column->per_seq = per_seq;
+    column->step = step;
+    column->size = size;
+}
+
+int32_t adi_adpd7000_fifo_view_init(adi_adpd7000_fifo_view_t *view, adi_adpd7000_fifo_config_t *fifo, const uint8_t *data, uint32_t size)
+{
+    if ((view == NULL) || (fifo == NULL) || (data == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((fifo->sequence_size == 0) || (fifo->ecg_over_sample > ADPD7000_ECG_MAX_OVER_SAMPLE) || (fifo->ppg_slot > ADPD7000_PPG_MAX_SLOT) ||
+        (fifo->bioz_slot > ADPD7000_BIOZ_MAX_SLOT))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    view->data = data;
+    view->fifo = fifo;
+    view->seq_num = size / fifo->sequence_size;
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_view_ecg(adi_adpd7000_fifo_view_t *view, adi_adpd7000_column_view_t *column)
+{
+    uint8_t status;
+
+    if ((view == NULL) || (column == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (!view->fifo->ecg_slot)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    /* status byte leads the sample */
+    status = (view->fifo->ecg_size == 4) ? 1 : 0;
+    adi_adpd7000_view_set_column(view, status, view->fifo->ecg_over_sample, view->fifo->ecg_size, 3, column);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_view_ecg_status(adi_adpd7000_fifo_view_t *view, adi_adpd7000_column_view_t *column)
+{
+    if ((view == NULL) || (column == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (!view->fifo->ecg_slot)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    adi_adpd7000_view_set_column(view, 0, view->fifo->ecg_over_sample, view->fifo->ecg_size, (view->fifo->ecg_size == 4) ? 1 : 0, column);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_view_ppg(adi_adpd7000_fifo_view_t *view, uint8_t slot, uint8_t channel, adi_adpd7000_ppg_field_e field,
+    adi_adpd7000_column_view_t *column)
+{
+    uint32_t offset;
+    uint8_t  size;
+    adi_adpd7000_ppg_fifo_config_t *ppg;
+
+    if ((view == NULL) || (column == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if ((slot >= view->fifo->ppg_slot) || (channel > view->fifo->ppg_fifo[slot].ppg_chl2_en) || (field > API_ADPD7000_PPG_FIELD_LIT))
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    ppg = &view->fifo->ppg_fifo[slot];
+    offset = adi_adpd7000_view_ecg_bytes(view->fifo) + adi_adpd7000_view_ppg_bytes(view->fifo, slot) +
+             channel * (ppg->signal_size + ppg->dark_size + ppg->lit_size);
+    if (field == API_ADPD7000_PPG_FIELD_SIGNAL)
+    {
+        size = ppg->signal_size;
+    }
+    else if (field == API_ADPD7000_PPG_FIELD_DARK)
+    {
+        offset += ppg->signal_size;
+        size = ppg->dark_size;
+    }
+    else
+    {
+        offset += ppg->signal_size + ppg->dark_size;
+        size = ppg->lit_size;
+    }
+    adi_adpd7000_view_set_column(view, offset, 1, 0, size, column);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_fifo_view_bioz(adi_adpd7000_fifo_view_t *view, uint8_t slot, bool imag, adi_adpd7000_column_view_t *column)
+{
+    uint32_t offset;
+
+    if ((view == NULL) || (column == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (slot >= view->fifo->bioz_slot)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    offset = adi_adpd7000_view_ecg_bytes(view->fifo) + adi_adpd7000_view_ppg_bytes(view->fifo, view->fifo->ppg_slot) + slot * 6 + (imag ? 3 : 0);
+    adi_adpd7000_view_set_column(view, offset, 1, 0, 3, column);
+
+    return API_ADPD7000_ERROR_OK;
+}
+
+int32_t adi_adpd7000_column_get(const adi_adpd7000_column_view_t *column, uint32_t index, uint32_t *value)
+{
+    uint8_t  k;
+    uint32_t data = 0;
+    const uint8_t *p;
+
+    if ((column == NULL) || (value == NULL))
+        return API_ADPD7000_ERROR_NULL_PARAM;
+    if (index >= column->len)
+        return API_ADPD7000_ERROR_INVALID_PARAM;
+
+    p = column->data + (index / column->per_seq) * column->sequence_size + (index % column->per_seq) * column->step;
+    for (k = 0; k < column->size; k++)
+    {
+        data = (data << 8) | p[k];
+    }
+    *value = data;
+
+    return API_ADPD7000_ERROR_OK;
+}
+/*! @} */
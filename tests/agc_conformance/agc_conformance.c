@@ -0,0 +1,195 @@
+/*!
+ * @brief     AGC conformance test, float and fixed point (ADPD7000_AGC_FIXED_POINT) builds of the AGC step
+ *            must take the same TIA gain, LED current and done decisions
+ *
+ * Checks a random sweep of the input space, targets next to the 1, 127 and integer boundaries, and
+ * closed loop replay of the traces in agc_traces.txt where each build drives its own gains.
+ *
+ * Build and run from the repository root:
+ *   cc -std=c99 -O2 -Iinc tests/agc_conformance/agc_*.c src/adi_adpd7000_*.c -lm -o agc_conformance
+ *   ./agc_conformance tests/agc_conformance/agc_traces.txt
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+#define AGC_CONFORMANCE_SWEEP       (20000000)                  /*!< Random cases */
+#define AGC_CONFORMANCE_REPORT      (10)                        /*!< Mismatches printed */
+#define AGC_CONFORMANCE_MAX_AVG     (16)                        /*!< Max average number of a trace */
+
+/*============= D A T A ====================*/
+void agc_float_step(adi_adpd7000_agc_t *agc, uint8_t slot);
+void agc_fixed_step(adi_adpd7000_agc_t *agc, uint8_t slot);
+
+static uint64_t rnd_state = 88172645463325252ULL;
+static unsigned long case_num, fail_num;
+
+/*============= C O D E ====================*/
+static uint32_t agc_conformance_rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return (uint32_t)(rnd_state >> 16);
+}
+
+static int agc_conformance_same(const adi_adpd7000_agc_t *a, const adi_adpd7000_agc_t *b)
+{
+    return (a->slot[0].run.tia_gain == b->slot[0].run.tia_gain) && (a->slot[0].run.led_current == b->slot[0].run.led_current) &&
+           (a->slot[0].run.agc_done == b->slot[0].run.agc_done);
+}
+
+static void agc_conformance_init(adi_adpd7000_agc_t *agc, uint16_t avg_num, uint8_t power_first, uint8_t agc_type,
+    uint32_t full_scale, uint8_t tia_gain, uint8_t led_current)
+{
+    memset(agc, 0, sizeof(adi_adpd7000_agc_t));
+    agc->cfg.ppg_average_sample_number = avg_num;
+    agc->cfg.power_first_en = power_first;
+    agc->cfg.slot[0].agc_type = agc_type;
+    agc->slot[0].run.ppg_full_scale = full_scale;
+    agc->slot[0].run.tia_gain = tia_gain;
+    agc->slot[0].run.led_current = led_current;
+}
+
+static void agc_conformance_check(uint32_t sum, uint16_t avg_num, uint32_t full_scale, uint8_t tia_gain, uint8_t led_current,
+    uint8_t power_first, uint8_t agc_type)
+{
+    adi_adpd7000_agc_t a, b;
+
+    agc_conformance_init(&a, avg_num, power_first, agc_type, full_scale, tia_gain, led_current);
+    a.slot[0].run.ppg_data_sum = sum;
+    b = a;
+    agc_float_step(&a, 0);
+    agc_fixed_step(&b, 0);
+    case_num++;
+    if (!agc_conformance_same(&a, &b) && (fail_num++ < AGC_CONFORMANCE_REPORT))
+    {
+        printf("mismatch sum %u avg %u fs %u gain %u led %u pf %u: float %u %u %u, fixed %u %u %u\n", sum, avg_num, full_scale,
+            tia_gain, led_current, power_first, a.slot[0].run.tia_gain, a.slot[0].run.led_current, a.slot[0].run.agc_done,
+            b.slot[0].run.tia_gain, b.slot[0].run.led_current, b.slot[0].run.agc_done);
+    }
+}
+
+/* front end model: counts scale with LED current, halve per TIA gain step and clip at full scale */
+static uint32_t agc_conformance_sample(const adi_adpd7000_agc_t *agc, uint32_t counts)
+{
+    uint64_t v = ((uint64_t)counts * agc->slot[0].run.led_current / 32) >> agc->slot[0].run.tia_gain;
+
+    return (v > agc->slot[0].run.ppg_full_scale) ? agc->slot[0].run.ppg_full_scale : (uint32_t)v;
+}
+
+static int agc_conformance_traces(const char *path)
+{
+    FILE *fp;
+    char line[128];
+    unsigned avg_num = 0, power_first, full_scale, tia_gain, led_current, counts, n = 0, trace = 0, step = 0;
+    int diverged = 0;
+    adi_adpd7000_agc_t a, b;
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (sscanf(line, "T %u %u %u %u %u", &avg_num, &power_first, &full_scale, &tia_gain, &led_current) == 5)
+        {
+            if ((avg_num == 0) || (avg_num > AGC_CONFORMANCE_MAX_AVG))
+                break;
+            agc_conformance_init(&a, (uint16_t)avg_num, (uint8_t)power_first, 0, full_scale, (uint8_t)tia_gain, (uint8_t)led_current);
+            b = a;
+            n = 0;
+            step = 0;
+            diverged = 0;
+            trace++;
+        }
+        else if ((sscanf(line, "S %u", &counts) == 1) && (avg_num != 0) && !diverged)
+        {
+            a.slot[0].run.ppg_data_sum += agc_conformance_sample(&a, counts);
+            b.slot[0].run.ppg_data_sum += agc_conformance_sample(&b, counts);
+            if (++n < avg_num)
+                continue;
+            agc_float_step(&a, 0);
+            agc_fixed_step(&b, 0);
+            a.slot[0].run.ppg_data_sum = 0;
+            b.slot[0].run.ppg_data_sum = 0;
+            n = 0;
+            step++;
+            case_num++;
+            if (!agc_conformance_same(&a, &b))
+            {
+                diverged = 1;
+                if (fail_num++ < AGC_CONFORMANCE_REPORT)
+                    printf("trace %u diverged at step %u\n", trace, step);
+            }
+        }
+    }
+    fclose(fp);
+    if (trace == 0)
+    {
+        printf("%s: no trace\n", path);
+        return -1;
+    }
+    printf("%u traces replayed\n", trace);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long i;
+    uint32_t full_scale, sum, led, c, avg;
+    int d, g, pf;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <agc_traces.txt>\n", argv[0]);
+        return 2;
+    }
+
+    for (i = 0; i < AGC_CONFORMANCE_SWEEP; i++)
+    {
+        full_scale = 16383 * (1 + agc_conformance_rnd() % 255) * (1 + agc_conformance_rnd() % 255);
+        if (agc_conformance_rnd() % 4 == 0)
+            full_scale = 16383 * (1 + agc_conformance_rnd() % 4);
+        /* sums of every magnitude, down to 0 */
+        d = (int)(agc_conformance_rnd() % 33);
+        sum = (d == 32) ? 0 : (agc_conformance_rnd() >> d);
+        avg = 1 + agc_conformance_rnd() % ((agc_conformance_rnd() % 2) ? 8 : 65535);
+        agc_conformance_check(sum, (uint16_t)avg, full_scale, (uint8_t)(agc_conformance_rnd() % 8), (uint8_t)agc_conformance_rnd(),
+            (uint8_t)(agc_conformance_rnd() % 2), (uint8_t)(agc_conformance_rnd() % 2));
+    }
+
+    /* sum chosen so the LED current target lands next to c */
+    for (led = 0; led < 256; led++)
+    {
+        for (c = 1; c <= 130; c++)
+        {
+            for (d = -3; d <= 3; d++)
+            {
+                if ((int64_t)led * 16383 / 2 / c - 1 + d < 0)
+                    continue;
+                for (pf = 0; pf < 2; pf++)
+                {
+                    for (g = 0; g < 6; g += 5)
+                    {
+                        agc_conformance_check((uint32_t)((int64_t)led * 16383 / 2 / c - 1 + d), 1, 16383, (uint8_t)g, (uint8_t)led,
+                            (uint8_t)pf, 1);
+                    }
+                }
+            }
+        }
+    }
+
+    if (agc_conformance_traces(argv[1]) != 0)
+        return 1;
+
+    printf("%lu cases, %lu mismatches\n", case_num, fail_num);
+    return (fail_num == 0) ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+/*!
+ * @brief     AGC conformance, float build of the AGC engine
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*============= I N C L U D E S ============*/
+#define ADPD7000_AGC_FIXED_POINT            0
+#define adi_adpd7000_agc_init               agc_float_init
+#define adi_adpd7000_agc_process            agc_float_process
+#define adi_adpd7000_agc_set_update_mode    agc_float_set_update_mode
+#define adi_adpd7000_agc_apply              agc_float_apply
+#include "../../src/adi_adpd7000_agc.c"
+
+/*============= C O D E ====================*/
+void agc_float_step(adi_adpd7000_agc_t *agc, uint8_t slot)
+{
+    adi_adpd7000_agc_step(agc, slot);
+}
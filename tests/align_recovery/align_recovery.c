@@ -0,0 +1,107 @@
+/*!
+ * @brief     Aligner recovery test, a channel stalls long enough for the other to run a queue ahead,
+ *            then delivers its backlog. Outputs of the stall are dropped once, then frames flow again.
+ *
+ * Build and run from the repository root:
+ *   cc -std=c99 -O2 -Iinc tests/align_recovery/align_recovery.c src/adi_adpd7000_*.c -lm -o align_recovery
+ *   ./align_recovery
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <math.h>
+#include <stdio.h>
+
+/*============= D E F I N E S ==============*/
+#define ALIGN_RECOVERY_PERIOD       (10000.0)                   /*!< 100 Hz channels and output, unit: us */
+#define ALIGN_RECOVERY_WARMUP       (100)                       /*!< Sample pairs before the stall */
+#define ALIGN_RECOVERY_STALL        (50)                        /*!< Samples channel 1 is late */
+#define ALIGN_RECOVERY_RUN          (1000)                      /*!< Sample pairs after the backlog */
+
+/*============= D A T A ====================*/
+static unsigned long frame_num;
+static double last_time = -1;
+static int bad_frame;
+
+/*============= C O D E ====================*/
+static double align_recovery_signal(uint8_t channel, uint32_t n)
+{
+    return (channel + 1) * 1000.0 + n;
+}
+
+static void align_recovery_cb(void *user_data, double time_us, const double *values, uint8_t channel_num)
+{
+    (void)user_data;
+    /* linear ramp is reproduced exactly by cubic interpolation, both channels agree on the sample index */
+    if ((channel_num != 2) || (time_us <= last_time) || (fabs((values[1] - 2000.0) - (values[0] - 1000.0)) > 1e-6))
+    {
+        bad_frame = 1;
+    }
+    last_time = time_us;
+    frame_num++;
+}
+
+int main(void)
+{
+    adi_adpd7000_align_t align;
+    uint8_t  ch0, ch1;
+    uint32_t n0 = 0, n1 = 0, i, drop;
+    unsigned long frames;
+    int fail = 0;
+
+    if ((adi_adpd7000_align_init(&align, 1000000.0 / ALIGN_RECOVERY_PERIOD, align_recovery_cb, NULL) != API_ADPD7000_ERROR_OK) ||
+        (adi_adpd7000_align_add_channel(&align, ALIGN_RECOVERY_PERIOD, 1, 1, 0, &ch0) != API_ADPD7000_ERROR_OK) ||
+        (adi_adpd7000_align_add_channel(&align, ALIGN_RECOVERY_PERIOD, 1, 1, 0, &ch1) != API_ADPD7000_ERROR_OK))
+    {
+        printf("init failed\n");
+        return 1;
+    }
+
+    for (i = 0; i < ALIGN_RECOVERY_WARMUP; i++)
+    {
+        adi_adpd7000_align_push(&align, ch0, align_recovery_signal(0, n0++));
+        adi_adpd7000_align_push(&align, ch1, align_recovery_signal(1, n1++));
+    }
+    /* channel 1 stalls, channel 0 runs more than a queue ahead */
+    for (i = 0; i < ALIGN_RECOVERY_STALL; i++)
+    {
+        adi_adpd7000_align_push(&align, ch0, align_recovery_signal(0, n0++));
+    }
+    drop = align.drop_count;
+    if (drop == 0)
+    {
+        printf("stall of %u samples dropped nothing, queue %u\n", ALIGN_RECOVERY_STALL, ADPD7000_ALIGN_QUEUE);
+        fail = 1;
+    }
+    /* backlog delivered */
+    for (i = 0; i < ALIGN_RECOVERY_STALL; i++)
+    {
+        adi_adpd7000_align_push(&align, ch1, align_recovery_signal(1, n1++));
+    }
+    frames = frame_num;
+    for (i = 0; i < ALIGN_RECOVERY_RUN; i++)
+    {
+        adi_adpd7000_align_push(&align, ch0, align_recovery_signal(0, n0++));
+        adi_adpd7000_align_push(&align, ch1, align_recovery_signal(1, n1++));
+    }
+
+    printf("drops %u during stall, %u after, %lu frames after backlog\n", drop, align.drop_count - drop, frame_num - frames);
+    if (align.drop_count != drop)
+    {
+        printf("drops after recovery\n");
+        fail = 1;
+    }
+    if (frame_num - frames < ALIGN_RECOVERY_RUN)
+    {
+        printf("aligner did not recover\n");
+        fail = 1;
+    }
+    if (bad_frame)
+    {
+        printf("misaligned frame\n");
+        fail = 1;
+    }
+    return fail;
+}
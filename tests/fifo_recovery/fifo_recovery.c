@@ -0,0 +1,157 @@
+/*!
+ * @brief     FIFO overflow recovery test, a drain buffer smaller than the backlog stops short of the sequence
+ *            cut by overflow while new sequences keep arriving behind it. Every sequence read must stay aligned.
+ *
+ * Build and run from the repository root:
+ *   cc -std=c99 -O2 -Iinc tests/fifo_recovery/fifo_recovery.c src/adi_adpd7000_*.c -lm -o fifo_recovery
+ *   ./fifo_recovery
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============= D E F I N E S ==============*/
+#define FIFO_RECOVERY_SEQ_SIZE      (4)                         /*!< Bytes of a sequence */
+#define FIFO_RECOVERY_BUF_SEQ       (3)                         /*!< Sequences the drain buffer takes */
+#define FIFO_RECOVERY_DRAIN         (20)                        /*!< Drains per run */
+#define FIFO_RECOVERY_REG_FIFO_DATA (0x2F)                      /*!< FIFO data register address */
+
+/*============= D A T A ====================*/
+static uint8_t  fifo_byte[4096];
+static uint32_t fifo_head, fifo_tail;
+static uint16_t fifo_flags;
+static uint8_t  seq_next;
+static unsigned seq_num, bad_num;
+
+/*============= C O D E ====================*/
+/* SPI model of the FIFO, reading past the data sets underflow, status errors are write 1 to clear */
+static int32_t fifo_recovery_read(void *user_data, uint8_t *rd_buf, uint32_t rd_len, uint8_t *wr_buf, uint32_t wr_len)
+{
+    uint16_t addr = (uint16_t)(((wr_buf[0] << 8) | wr_buf[1]) >> 1), v;
+    uint32_t i;
+
+    (void)user_data;
+    (void)wr_len;
+    for (i = 0; i < rd_len; i++)
+    {
+        if (addr != FIFO_RECOVERY_REG_FIFO_DATA)
+        {
+            v = (addr == 0) ? (uint16_t)(((fifo_tail - fifo_head) & 0x7FF) | fifo_flags) : 0;
+            rd_buf[i] = (i % 2) ? (uint8_t)v : (uint8_t)(v >> 8);
+        }
+        else if (fifo_head < fifo_tail)
+        {
+            rd_buf[i] = fifo_byte[fifo_head++];
+        }
+        else
+        {
+            rd_buf[i] = 0;
+            fifo_flags |= 0x4000;
+        }
+    }
+    return 0;
+}
+
+static int32_t fifo_recovery_write(void *user_data, uint8_t *wr_buf, uint32_t len)
+{
+    (void)user_data;
+    if ((len == 4) && ((((wr_buf[0] << 8) | wr_buf[1]) >> 1) == 0))
+    {
+        fifo_flags &= (uint16_t)~((wr_buf[2] << 8) | wr_buf[3]);
+    }
+    return 0;
+}
+
+static void fifo_recovery_push(unsigned num)
+{
+    unsigned i;
+
+    for (i = 0; i < num; i++)
+    {
+        fifo_byte[fifo_tail++] = seq_next;
+        fifo_byte[fifo_tail++] = seq_next;
+        fifo_byte[fifo_tail++] = seq_next;
+        fifo_byte[fifo_tail++] = (uint8_t)~seq_next;
+        seq_next++;
+    }
+}
+
+/* FIFO full in the middle of a sequence */
+static void fifo_recovery_cut(void)
+{
+    fifo_byte[fifo_tail++] = 0xEE;
+    fifo_byte[fifo_tail++] = 0xEE;
+    fifo_flags |= 0x2000;
+}
+
+static int fifo_recovery_run(adi_adpd7000_fifo_seq_track_t *track, uint16_t predict)
+{
+    adi_adpd7000_device_t device;
+    adi_adpd7000_fifo_config_t fifo;
+    adi_adpd7000_fifo_drain_t drain;
+    uint8_t  buf[FIFO_RECOVERY_BUF_SEQ * FIFO_RECOVERY_SEQ_SIZE], *s;
+    unsigned i, j, bad = 0;
+
+    memset(&device, 0, sizeof(device));
+    device.read = fifo_recovery_read;
+    device.write = fifo_recovery_write;
+    memset(&fifo, 0, sizeof(fifo));
+    fifo.sequence_size = FIFO_RECOVERY_SEQ_SIZE;
+    fifo.status_size = 1;
+    fifo_head = fifo_tail = 0;
+    fifo_flags = 0;
+    seq_next = 0;
+
+    fifo_recovery_push(10);
+    fifo_recovery_cut();
+    for (i = 0; i < FIFO_RECOVERY_DRAIN; i++)
+    {
+        if (adi_adpd7000_fifo_drain_fused(&device, &fifo, track, buf, sizeof(buf), predict, false, &drain) != API_ADPD7000_ERROR_OK)
+        {
+            printf("drain failed\n");
+            return 1;
+        }
+        for (j = 0; j < drain.seq_count; j++)
+        {
+            s = buf + j * FIFO_RECOVERY_SEQ_SIZE;
+            if ((s[0] != s[1]) || (s[1] != s[2]) || ((uint8_t)(s[3] ^ s[0]) != 0xFF))
+                bad++;
+        }
+        seq_num += drain.seq_count;
+        /* sequences written after the cut, then a second overflow while the first cut is still queued */
+        if (i == 0)
+            fifo_recovery_push(5);
+        if (i == 1)
+        {
+            fifo_recovery_push(2);
+            fifo_recovery_cut();
+        }
+        if (i == 2)
+            fifo_recovery_push(3);
+    }
+    printf("track %u predict %u: %u misaligned, %u bytes left, flags 0x%04X\n", (track != NULL), predict, bad, fifo_tail - fifo_head,
+        fifo_flags);
+    bad_num += bad;
+    return ((fifo_tail != fifo_head) || (fifo_flags != 0)) ? 1 : 0;
+}
+
+int main(void)
+{
+    adi_adpd7000_fifo_seq_track_t track;
+    int fail = 0;
+
+    memset(&track, 0, sizeof(track));
+    fail |= fifo_recovery_run(&track, 0);
+    memset(&track, 0, sizeof(track));
+    fail |= fifo_recovery_run(&track, 2 * FIFO_RECOVERY_SEQ_SIZE);
+    fail |= fifo_recovery_run(NULL, 0);
+
+    printf("%u sequences read, %u misaligned\n", seq_num, bad_num);
+    if ((bad_num != 0) || (seq_num == 0))
+        fail = 1;
+    return fail;
+}
@@ -0,0 +1,172 @@
+/*!
+ * @brief     Offline Capture Decoder
+ *
+ * Decodes a raw FIFO capture into per-channel columns, chunks are split across worker threads.
+ * Output is column major, value c of sequence s at u32 offset c * sequence total + s, native endian,
+ * value order @see adi_adpd7000_fifo_get_column_sizes.
+ *
+ * Build, POSIX host:
+ *   cc -std=c99 -O2 -D_POSIX_C_SOURCE=200809L -Iinc tools/adpd7000_decode.c src/adi_adpd7000_*.c -lm -lpthread -o adpd7000_decode
+ * Usage:
+ *   adpd7000_decode <capture> <output> [workers]
+ *
+ * @copyright Copyright (c) 2021 - Analog Devices Inc. All Rights Reserved.
+ */
+
+/*============= I N C L U D E S ============*/
+#include "adi_adpd7000.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*============= D E F I N E S ==============*/
+#define ADPD7000_DECODE_MAX_WORKER  (64)
+
+/*============= D A T A ====================*/
+typedef struct
+{
+    adi_adpd7000_capture_reader_t *reader;
+    uint32_t *columns;
+    uint32_t worker_num;
+    uint32_t worker;
+    int32_t  err;
+} adi_adpd7000_decode_job_t;
+
+/*============= C O D E ====================*/
+static void *adi_adpd7000_decode_worker(void *arg)
+{
+    adi_adpd7000_decode_job_t *job = (adi_adpd7000_decode_job_t *)arg;
+    uint32_t first_chunk, chunk_num;
+
+    job->err = adi_adpd7000_capture_split(job->reader, job->worker_num, job->worker, &first_chunk, &chunk_num);
+    if ((job->err == API_ADPD7000_ERROR_OK) && (chunk_num != 0))
+    {
+        job->err = adi_adpd7000_capture_decode_columns(job->reader, first_chunk, chunk_num, job->columns, 0,
+            job->reader->seq_total);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    int in_fd, out_fd, ret = 1;
+    struct stat st;
+    void *base = MAP_FAILED, *out = MAP_FAILED;
+    size_t out_size = 0;
+    uint8_t  sizes[ADPD7000_FIFO_MAX_COLUMN];
+    uint16_t col_num, c;
+    uint32_t i, worker_num = 0;
+    long cpu;
+    adi_adpd7000_capture_reader_t reader;
+    adi_adpd7000_decode_job_t job[ADPD7000_DECODE_MAX_WORKER];
+    pthread_t thread[ADPD7000_DECODE_MAX_WORKER];
+    uint8_t  started[ADPD7000_DECODE_MAX_WORKER];
+
+    if ((argc != 3) && (argc != 4))
+    {
+        fprintf(stderr, "usage: %s <capture> <output> [workers]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 4)
+    {
+        worker_num = (uint32_t)strtoul(argv[3], NULL, 0);
+    }
+    else
+    {
+        cpu = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_num = (cpu > 0) ? (uint32_t)cpu : 1;
+    }
+    if (worker_num == 0)
+        worker_num = 1;
+    if (worker_num > ADPD7000_DECODE_MAX_WORKER)
+        worker_num = ADPD7000_DECODE_MAX_WORKER;
+
+    in_fd = open(argv[1], O_RDONLY);
+    if ((in_fd < 0) || (fstat(in_fd, &st) != 0) || (st.st_size == 0))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, in_fd, 0);
+    close(in_fd);
+    if (base == MAP_FAILED)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    out_fd = -1;
+    if (adi_adpd7000_capture_open(&reader, base, (size_t)st.st_size) != API_ADPD7000_ERROR_OK)
+    {
+        fprintf(stderr, "%s: not a valid capture\n", argv[1]);
+        goto done;
+    }
+    if (adi_adpd7000_fifo_get_column_sizes(&reader.fifo, sizes, ADPD7000_FIFO_MAX_COLUMN, &col_num) != API_ADPD7000_ERROR_OK)
+    {
+        fprintf(stderr, "%s: unsupported sequence layout\n", argv[1]);
+        goto done;
+    }
+
+    out_size = (size_t)col_num * (size_t)reader.seq_total * sizeof(uint32_t);
+    out_fd = open(argv[2], O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if ((out_fd < 0) || (ftruncate(out_fd, (off_t)out_size) != 0))
+    {
+        perror(argv[2]);
+        goto done;
+    }
+    if (out_size != 0)
+    {
+        out = mmap(NULL, out_size, PROT_READ | PROT_WRITE, MAP_SHARED, out_fd, 0);
+        if (out == MAP_FAILED)
+        {
+            perror(argv[2]);
+            goto done;
+        }
+
+        /* chunks start on a sequence boundary, workers decode disjoint rows of the same columns */
+        for (i = 0; i < worker_num; i++)
+        {
+            job[i].reader = &reader;
+            job[i].columns = (uint32_t *)out;
+            job[i].worker_num = worker_num;
+            job[i].worker = i;
+            job[i].err = API_ADPD7000_ERROR_OK;
+            started[i] = (pthread_create(&thread[i], NULL, adi_adpd7000_decode_worker, &job[i]) == 0);
+            if (!started[i])
+                adi_adpd7000_decode_worker(&job[i]);
+        }
+        ret = 0;
+        for (i = 0; i < worker_num; i++)
+        {
+            if (started[i])
+                pthread_join(thread[i], NULL);
+            if (job[i].err != API_ADPD7000_ERROR_OK)
+            {
+                fprintf(stderr, "worker %u: decode error %d\n", (unsigned)i, (int)job[i].err);
+                ret = 1;
+            }
+        }
+    }
+    else
+    {
+        ret = 0;
+    }
+
+    printf("sequences %llu, columns %u, workers %u\n", (unsigned long long)reader.seq_total, (unsigned)col_num, (unsigned)worker_num);
+    for (c = 0; c < col_num; c++)
+    {
+        printf("column %u: %u bytes\n", (unsigned)c, (unsigned)sizes[c]);
+    }
+
+done:
+    if (out != MAP_FAILED)
+        munmap(out, out_size);
+    if (out_fd >= 0)
+        close(out_fd);
+    munmap(base, (size_t)st.st_size);
+    return ret;
+}